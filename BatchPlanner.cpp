@@ -0,0 +1,32 @@
+//
+// Created by Benjamin Lee on 8/27/24.
+//
+
+#include "BatchPlanner.h"
+
+namespace path {
+    void plan_paths(ThreadPool& pool, const std::vector<std::vector<Vector2>>& controlPoints,
+                    double sharpness, double maxCurvature, double ds, std::vector<WaypointBuffer>& output) {
+        output.resize(controlPoints.size());
+        pool.parallel_for(controlPoints.size(), [&](std::size_t i) {
+            // fill a local buffer so neighbouring results never share a cache line while being written
+            auto buffer = std::move(output[i]);
+            buffer.clear();
+
+            Path path(controlPoints[i], sharpness, maxCurvature);
+            buffer.reserve((std::size_t)(path.get_length() / ds) + 2 * path.get_curves().size());
+            // sample directly; these paths are used once, so filling the per-curve caches would be wasted work
+            for (auto curve: path.get_curves())
+                curve->get_waypoints_spaced(buffer, ds);
+
+            output[i] = std::move(buffer);
+        });
+    }
+
+    std::vector<WaypointBuffer> plan_paths(ThreadPool& pool, const std::vector<std::vector<Vector2>>& controlPoints,
+                                           double sharpness, double maxCurvature, double ds) {
+        std::vector<WaypointBuffer> output;
+        plan_paths(pool, controlPoints, sharpness, maxCurvature, ds, output);
+        return output;
+    }
+} // path
@@ -0,0 +1,33 @@
+//
+// Created by Benjamin Lee on 8/27/24.
+//
+
+#ifndef VEX_PATH_PLANNER_BATCHPLANNER_H
+#define VEX_PATH_PLANNER_BATCHPLANNER_H
+
+#include <vector>
+#include "Path.h"
+#include "ThreadPool.h"
+
+namespace path {
+    /**
+     * @brief build and sample many paths in parallel, one task per path.
+     * Every task builds its own Path (updating its joints) and samples it into its own buffer, so tasks share no
+     * state and the results do not depend on the number of threads. Returns once every path is sampled, running
+     * queued tasks on the calling thread meanwhile, so it may itself be called from inside a task of the pool.
+     * @param pool workers to run on
+     * @param controlPoints control points of each path, at least 2 per path
+     * @param sharpness rate of change in curvature of every clothoid
+     * @param maxCurvature maximum curvature of every turn
+     * @param ds space between waypoints
+     * @param output set to one buffer per path, in the same order as controlPoints. Existing buffers are reused.
+     */
+    void plan_paths(ThreadPool& pool, const std::vector<std::vector<Vector2>>& controlPoints,
+                    double sharpness, double maxCurvature, double ds, std::vector<WaypointBuffer>& output);
+
+    [[nodiscard]] std::vector<WaypointBuffer> plan_paths(ThreadPool& pool,
+                                                         const std::vector<std::vector<Vector2>>& controlPoints,
+                                                         double sharpness, double maxCurvature, double ds);
+} // path
+
+#endif //VEX_PATH_PLANNER_BATCHPLANNER_H
@@ -0,0 +1,424 @@
+//
+// Created by Benjamin Lee on 9/5/24.
+//
+
+#include "BatchPlanner.h"
+#include "BoundingBoxSet.h"
+#include "Joint.h"
+#include "MathUtils.h"
+#include "WaypointBuffer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+/*
+ * Micro-benchmarks of the batched and precomputed paths against the straightforward code they replace. Each prints the
+ * time per operation of both, their ratio, and a checksum of the results so the work cannot be optimized away and the
+ * two sides can be seen to agree.
+ */
+
+using namespace path;
+
+namespace {
+    std::mt19937 rng(2024);
+
+    double uniform(double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+    }
+
+    /**
+     * @brief run f repeatedly for at least minSeconds
+     * @param f work to time; returns a checksum of its results
+     * @param checksum set to the checksum of the last run
+     * @return seconds per run
+     */
+    double time_per_run(const std::function<std::uint64_t()>& f, std::uint64_t& checksum, double minSeconds = 0.2) {
+        using clock = std::chrono::steady_clock;
+        checksum = f(); // warm up
+        int runs = 0;
+        auto start = clock::now();
+        std::chrono::duration<double> elapsed {};
+        do {
+            checksum = f();
+            ++runs;
+            elapsed = clock::now() - start;
+        } while (elapsed.count() < minSeconds);
+        return elapsed.count() / runs;
+    }
+
+    /**
+     * @brief time a baseline and a replacement doing the same number of operations, and report both
+     * @param sameResults whether the two must produce the same checksum; flags a mismatch if so
+     */
+    void compare(const char* name, double operations, const std::function<std::uint64_t()>& baseline,
+                 const std::function<std::uint64_t()>& replacement, bool sameResults = true) {
+        std::uint64_t baseSum;
+        std::uint64_t newSum;
+        auto baseTime = time_per_run(baseline, baseSum) / operations * 1e9;
+        auto newTime = time_per_run(replacement, newSum) / operations * 1e9;
+        std::printf("%-44s %9.2f ns -> %9.2f ns  %6.2fx  checksums %llu %llu%s\n", name, baseTime, newTime,
+                    baseTime / newTime, (unsigned long long)baseSum, (unsigned long long)newSum,
+                    baseSum == newSum || !sameResults ? "" : "  MISMATCH");
+    }
+
+    /**
+     * @return index of the lowest set bit, bits != 0
+     */
+    int lowest_bit(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int i = 0;
+        while (!(bits & 1)) {
+            bits >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    /**
+     * @brief checksum of a sampled curve: the number of points and the last one rounded to 1e-6, cheap enough not to
+     * skew the timing
+     */
+    std::uint64_t checksum(const std::vector<Vector2>& points) {
+        if (points.empty())
+            return 0;
+        return (points.size() * 31 + (std::uint64_t)std::llround(points.back().x * 1e6)) * 31 +
+               (std::uint64_t)std::llround(points.back().y * 1e6);
+    }
+
+    std::vector<BoundingBox> random_boxes(int n, double field, double maxSize) {
+        std::vector<BoundingBox> boxes;
+        boxes.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            Vector2 corner(uniform(-field, field), uniform(-field, field));
+            boxes.emplace_back(corner, corner + Vector2(uniform(0, maxSize), uniform(0, maxSize)));
+        }
+        return boxes;
+    }
+
+    /**
+     * @brief BoundingBoxSet overlap bitmasks against a loop of BoundingBox::operator&&, one query against many boxes
+     * and many against many. Per operation is per box pair.
+     */
+    void bench_bounding_box_set() {
+        std::printf("BoundingBoxSet (batch width %d) vs BoundingBox::operator&&\n", BOUNDING_BOX_BATCH_WIDTH);
+        for (int n: {64, 1024, 16384}) {
+            auto boxes = random_boxes(n, 100, 10);
+            auto queries = random_boxes(256, 100, 10);
+            BoundingBoxSet set(boxes);
+            BoundingBoxSet querySet(queries);
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "one vs %d", n);
+            std::vector<std::uint64_t> mask(set.mask_words());
+            compare(name, (double)n * queries.size(), [&] {
+                std::uint64_t sum = 0;
+                for (auto& query: queries) {
+                    for (int i = 0; i < n; ++i) {
+                        if (query && boxes[i])
+                            sum += i;
+                    }
+                }
+                return sum;
+            }, [&] {
+                std::uint64_t sum = 0;
+                for (auto& query: queries) {
+                    set.overlaps(query, mask.data());
+                    for (std::size_t w = 0; w < mask.size(); ++w) {
+                        for (auto bits = mask[w]; bits; bits &= bits - 1)
+                            sum += w * 64 + lowest_bit(bits);
+                    }
+                }
+                return sum;
+            });
+
+            std::snprintf(name, sizeof(name), "%d vs %d", (int)queries.size(), n);
+            std::vector<std::uint64_t> masks(queries.size() * set.mask_words());
+            compare(name, (double)n * queries.size(), [&] {
+                std::uint64_t sum = 0;
+                for (std::size_t j = 0; j < queries.size(); ++j) {
+                    for (int i = 0; i < n; ++i) {
+                        if (queries[j] && boxes[i])
+                            sum += j ^ i;
+                    }
+                }
+                return sum;
+            }, [&] {
+                set.overlaps(querySet, masks.data());
+                std::uint64_t sum = 0;
+                auto words = set.mask_words();
+                for (std::size_t j = 0; j < queries.size(); ++j) {
+                    for (std::size_t w = 0; w < words; ++w) {
+                        for (auto bits = masks[j * words + w]; bits; bits &= bits - 1)
+                            sum += j ^ (w * 64 + lowest_bit(bits));
+                    }
+                }
+                return sum;
+            });
+        }
+    }
+
+    /**
+     * @brief f as it is, or behind a std::function as every MathUtils routine took it before the callable overloads
+     */
+    template <bool Erased, typename F>
+    auto integrand(F f) {
+        if constexpr (Erased)
+            return std::function<decltype(f(0.0))(double)>(f);
+        else
+            return f;
+    }
+
+    /**
+     * @brief sample a joint's curves at spacing ds through the MathUtils routines, the way Joint::get_waypoints
+     * did before it was specialized per curve: lines and the arc with map_interval_spaced, clothoids with
+     * moving_integral_spaced over the unit tangent
+     */
+    template <bool Erased>
+    void sample_with_math_utils(const Joint& joint, double ds, std::vector<Vector2>& output) {
+        for (auto line: {&joint.get_line1(), &joint.get_line2()}) {
+            auto start = line->get_start();
+            auto direction = (line->get_end() - start).normalize();
+            map_interval_spaced<double, Vector2>(output, integrand<Erased>([=](double t) {
+                return start + direction * t;
+            }), 0.0, line->get_length(), ds);
+        }
+
+        for (auto clothoid: {&joint.get_clothoid1(), &joint.get_clothoid2()}) {
+            auto sigma2 = clothoid->get_sharpness() / 2;
+            auto kappa0 = clothoid->get_initial_curvature();
+            auto theta0 = clothoid->get_initial_heading();
+            moving_integral_spaced<double, Vector2>(output, integrand<Erased>([=](double x) {
+                auto theta = (sigma2 * x + kappa0) * x + theta0;
+                return Vector2(std::cos(theta), std::sin(theta));
+            }), 0.0, clothoid->get_length(), ds, clothoid->get_initial_position());
+        }
+
+        auto& arc = joint.get_arc();
+        if (arc.is_visible()) {
+            auto center = arc.get_center();
+            auto radius = arc.get_radius();
+            map_interval_spaced<double, Vector2>(output, integrand<Erased>([=](double theta) {
+                return center + Vector2(std::cos(theta), std::sin(theta)) * radius;
+            }), arc.get_start_angle(), arc.get_end_angle(), ds / radius);
+        }
+    }
+
+    /**
+     * @brief per-waypoint cost of sampling the joint from main.cpp through std::function against generic callables,
+     * and of the current Joint::get_waypoints into a fixed buffer, which bypasses the cache
+     */
+    void bench_joint_waypoints() {
+        std::printf("Joint::get_waypoints path, per waypoint\n");
+        Vector2 start(0, 4);
+        Vector2 middle(0, 1);
+        Vector2 end(-2, 2);
+        Joint joint(&start, &middle, &end, 2.75, 2);
+        joint.update();
+
+        for (double ds: {0.01, 0.001}) {
+            std::vector<Vector2> points;
+            sample_with_math_utils<false>(joint, ds, points);
+            auto count = (double)points.size();
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "std::function -> callable, ds %g", ds);
+            compare(name, count, [&] {
+                points.clear();
+                sample_with_math_utils<true>(joint, ds, points);
+                return checksum(points);
+            }, [&] {
+                points.clear();
+                sample_with_math_utils<false>(joint, ds, points);
+                return checksum(points);
+            });
+
+            // different quadrature and end handling, so only the waypoint counts are compared, and they may differ by
+            // a point per curve
+            static WaypointStorage<1 << 16> storage;
+            WaypointBuffer buffer(storage);
+            std::snprintf(name, sizeof(name), "std::function -> get_waypoints, ds %g", ds);
+            compare(name, count, [&] {
+                points.clear();
+                sample_with_math_utils<true>(joint, ds, points);
+                return (std::uint64_t)points.size();
+            }, [&] {
+                buffer.clear();
+                joint.get_waypoints(buffer, ds);
+                return (std::uint64_t)buffer.size();
+            }, false);
+        }
+    }
+
+    /**
+     * @brief std::function against a generic callable where the integrand is cheap arithmetic: the heading of a
+     * clothoid as the running integral of its linear curvature, and the Simpson sum of its quadratic heading. Unlike the
+     * cos/sin integrands of the joint, the callable can be inlined into the loop and its arithmetic vectorized.
+     */
+    void bench_arithmetic_integrand() {
+        std::printf("clothoid heading and curvature integrands, per evaluation\n");
+        auto sigma2 = 1.375;
+        auto kappa0 = -0.4;
+        auto theta0 = 0.3;
+        auto curvature = [=](double x) { return 2 * sigma2 * x + kappa0; };
+        auto heading = [=](double x) { return (sigma2 * x + kappa0) * x + theta0; };
+        auto round = [](double x) { return (std::uint64_t)std::llround(x * 1e6); };
+
+        for (double ds: {0.001, 0.0001}) {
+            constexpr double LENGTH = 2;
+            std::vector<double> headings;
+            char name[64];
+            std::snprintf(name, sizeof(name), "moving_integral_spaced, ds %g", ds);
+            auto sample = [&](auto&& f) {
+                headings.clear();
+                moving_integral_spaced<double, double>(headings, f, 0.0, LENGTH, ds, theta0);
+                return headings.size() * 31 + round(headings.back());
+            };
+            compare(name, 2 * LENGTH / ds, [&] {
+                return sample(integrand<true>(curvature));
+            }, [&] {
+                return sample(integrand<false>(curvature));
+            });
+        }
+
+        constexpr int STEPS = 1 << 16;
+        compare("integral, 2^16 steps", 2.0 * STEPS, [&] {
+            return round(integral<double, double>(integrand<true>(heading), 0.0, 2.0, STEPS));
+        }, [&] {
+            return round(integral<double, double>(integrand<false>(heading), 0.0, 2.0, STEPS));
+        });
+    }
+
+    /**
+     * @brief checksum of every position in a buffer: the count and the sums of x and y rounded to 1e-6. Summing keeps
+     * it cheap next to the sampling, and the recurrence's error is far below the rounding.
+     */
+    std::uint64_t checksum(const WaypointBuffer& buffer) {
+        double sumX = 0;
+        double sumY = 0;
+        for (std::size_t i = 0; i < buffer.size(); ++i) {
+            sumX += buffer.x()[i];
+            sumY += buffer.y()[i];
+        }
+        return (buffer.size() * 31 + (std::uint64_t)std::llround(sumX * 1e6)) * 31 +
+               (std::uint64_t)std::llround(sumY * 1e6);
+    }
+
+    /**
+     * @brief CircularArc::get_waypoints_spaced with a cos/sin call per point instead of the rotation recurrence
+     */
+    void arc_waypoints_cos_sin(const CircularArc& arc, WaypointBuffer& output, double ds) {
+        auto center = arc.get_center();
+        auto radius = arc.get_radius();
+        auto thetaStart = arc.get_start_angle();
+        auto thetaEnd = arc.get_end_angle();
+        auto turn = thetaEnd < thetaStart ? -1.0 : 1.0;
+        auto kappa = turn / radius;
+        auto dTheta = ds / radius;
+        auto sweep = std::fabs(thetaEnd - thetaStart);
+        auto steps = (int)(sweep / dTheta);
+        bool useEnd = (sweep - steps * dTheta) * radius > 0.001;
+        auto s0 = output.length();
+        output.reserve(output.size() + steps + useEnd + 1);
+
+        for (int k = 0; k <= steps; ++k) {
+            auto theta = thetaStart + turn * k * dTheta;
+            output.push_back(center + Vector2(std::cos(theta), std::sin(theta)) * radius, theta + turn * M_PI_2, kappa,
+                             s0 + radius * k * dTheta);
+        }
+        if (useEnd) {
+            output.push_back(center + Vector2(std::cos(thetaEnd), std::sin(thetaEnd)) * radius,
+                             thetaEnd + turn * M_PI_2, kappa, s0 + radius * sweep);
+        }
+    }
+
+    /**
+     * @brief CircularArc waypoints by cos/sin per point against the rotation recurrence, sampled directly into a fixed
+     * buffer so the waypoint cache is bypassed
+     */
+    void bench_arc_recurrence() {
+        std::printf("CircularArc waypoints, per waypoint\n");
+        static WaypointStorage<1 << 16> storage;
+        WaypointBuffer buffer(storage);
+        CircularArc arc({1, 2}, 0.3, 0.3 + 1.5 * M_PI, 2);
+
+        for (double ds: {0.01, 0.001}) {
+            buffer.clear();
+            arc.get_waypoints_spaced(buffer, ds);
+            auto count = (double)buffer.size();
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "cos/sin -> recurrence, ds %g", ds);
+            compare(name, count, [&] {
+                buffer.clear();
+                arc_waypoints_cos_sin(arc, buffer, ds);
+                return checksum(buffer);
+            }, [&] {
+                buffer.clear();
+                arc.get_waypoints_spaced(buffer, ds);
+                return checksum(buffer);
+            });
+        }
+    }
+
+    /**
+     * @brief plan_paths throughput on pools of 1, 2, 4, ... up to the hardware thread count, with the speedup over one
+     * thread. Every pool must produce the same waypoints, so a differing checksum is flagged.
+     */
+    void bench_batch_planner() {
+        auto hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::printf("plan_paths throughput, %u hardware thread(s)\n", hardware);
+        constexpr int PATHS = 256;
+        constexpr double DS = 0.01;
+        std::vector<std::vector<Vector2>> controlPoints(PATHS);
+        for (auto& points: controlPoints) {
+            // a random walk with steps long enough for every joint to fit its turn
+            Vector2 point(uniform(-10, 10), uniform(-10, 10));
+            for (int i = 0; i < 6; ++i) {
+                points.push_back(point);
+                auto angle = uniform(-M_PI, M_PI);
+                point += Vector2(std::cos(angle), std::sin(angle)) * uniform(3, 6);
+            }
+        }
+
+        std::vector<WaypointBuffer> output;
+        double baseTime = 0;
+        std::uint64_t baseSum = 0;
+        for (unsigned threads = 1;; threads = std::min(threads * 2, hardware)) {
+            ThreadPool pool(threads);
+            std::uint64_t sum;
+            auto time = time_per_run([&] {
+                plan_paths(pool, controlPoints, 2.75, 2, DS, output);
+                std::uint64_t result = 0;
+                for (auto& buffer: output) {
+                    result = result * 31 + buffer.size();
+                    if (!buffer.empty())
+                        result = result * 31 + (std::uint64_t)std::llround(buffer.x()[buffer.size() - 1] * 1e6);
+                }
+                return result;
+            }, sum);
+            if (threads == 1) {
+                baseTime = time;
+                baseSum = sum;
+            }
+            std::printf("%2u thread(s) %10.0f paths/s  %6.2fx  checksum %llu%s\n", threads, PATHS / time,
+                        baseTime / time, (unsigned long long)sum, sum == baseSum ? "" : "  MISMATCH");
+            if (threads == hardware)
+                break;
+        }
+    }
+}
+
+int main() {
+    bench_bounding_box_set();
+    bench_joint_waypoints();
+    bench_arithmetic_integrand();
+    bench_arc_recurrence();
+    bench_batch_planner();
+}
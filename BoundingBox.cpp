@@ -4,6 +4,7 @@
 
 #include "BoundingBox.h"
 #include <cassert>
+#include <cmath>
 
 namespace path {
     BoundingBox::BoundingBox(const Vector2 &cornerMin, const Vector2 &cornerMax) :
@@ -13,12 +14,17 @@ namespace path {
         assert(cornerMin.x <= cornerMax.x && cornerMin.y <= cornerMax.y);
     }
 
+    BoundingBox::BoundingBox(const Vector2 &point) :
+        cornerMin(point),
+        cornerMax(point)
+    {}
+
     const Vector2 &BoundingBox::get_corner_max() const {
-        return cornerMin;
+        return cornerMax;
     }
 
     const Vector2 &BoundingBox::get_corner_min() const {
-        return cornerMax;
+        return cornerMin;
     }
 
     void BoundingBox::set_corner_min(const Vector2 &pos) {
@@ -38,4 +44,27 @@ namespace path {
         return *this && other;
     }
 
+    bool BoundingBox::contains(const Vector2 &point) const {
+        return this->cornerMin.x <= point.x && point.x <= this->cornerMax.x &&
+               this->cornerMin.y <= point.y && point.y <= this->cornerMax.y;
+    }
+
+    void BoundingBox::expand(const Vector2 &point) {
+        this->cornerMin = {std::fmin(this->cornerMin.x, point.x), std::fmin(this->cornerMin.y, point.y)};
+        this->cornerMax = {std::fmax(this->cornerMax.x, point.x), std::fmax(this->cornerMax.y, point.y)};
+    }
+
+    void BoundingBox::expand(const BoundingBox &other) {
+        this->expand(other.cornerMin);
+        this->expand(other.cornerMax);
+    }
+
+    Vector2 BoundingBox::get_center() const {
+        return (this->cornerMin + this->cornerMax) / 2;
+    }
+
+    Vector2 BoundingBox::get_size() const {
+        return this->cornerMax - this->cornerMin;
+    }
+
 } // path
\ No newline at end of file
@@ -12,6 +12,12 @@ namespace path {
     public:
         BoundingBox(const Vector2 &cornerMin, const Vector2 &cornerMax);
 
+        /**
+         * @brief degenerate box around a single point
+         * @param point the only point in the box
+         */
+        explicit BoundingBox(const Vector2 &point);
+
         void set_corner_min(const Vector2 &pos);
         void set_corner_max(const Vector2 &pos);
 
@@ -27,6 +33,23 @@ namespace path {
          */
         bool operator&&(const BoundingBox& other) const;
 
+        [[nodiscard]] bool contains(const Vector2& point) const;
+
+        /**
+         * @brief grow the box to include a point
+         * @param point point to include
+         */
+        void expand(const Vector2& point);
+
+        /**
+         * @brief grow the box to include another box
+         * @param other box to include
+         */
+        void expand(const BoundingBox& other);
+
+        [[nodiscard]] Vector2 get_center() const;
+        [[nodiscard]] Vector2 get_size() const;
+
     private:
         Vector2 cornerMin; // (xMin, yMin)
         Vector2 cornerMax; // (xMax, yMax)
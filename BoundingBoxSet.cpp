@@ -0,0 +1,190 @@
+//
+// Created by Benjamin Lee on 9/1/24.
+//
+
+#include "BoundingBoxSet.h"
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOXSET_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BOXSET_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BOXSET_NEON
+#endif
+
+namespace path {
+    // boxes per mask word; storage is padded to this so every word can be computed without a tail loop
+    static constexpr std::size_t WORD_BITS = 64;
+
+    BoundingBoxSet::BoundingBoxSet(const std::vector<BoundingBox>& boxes) {
+        for (const auto& box: boxes)
+            this->push_back(box);
+    }
+
+    void BoundingBoxSet::push_back(const BoundingBox& box) {
+        if (this->count == this->xMin.size()) {
+            auto padded = this->count + WORD_BITS;
+            auto inf = std::numeric_limits<double>::infinity();
+            this->xMin.resize(padded, inf);
+            this->yMin.resize(padded, inf);
+            this->xMax.resize(padded, -inf);
+            this->yMax.resize(padded, -inf);
+        }
+        this->xMin[this->count] = box.get_corner_min().x;
+        this->yMin[this->count] = box.get_corner_min().y;
+        this->xMax[this->count] = box.get_corner_max().x;
+        this->yMax[this->count] = box.get_corner_max().y;
+        ++this->count;
+    }
+
+    void BoundingBoxSet::clear() {
+        this->xMin.clear();
+        this->yMin.clear();
+        this->xMax.clear();
+        this->yMax.clear();
+        this->count = 0;
+    }
+
+    std::size_t BoundingBoxSet::size() const {
+        return this->count;
+    }
+
+    bool BoundingBoxSet::empty() const {
+        return this->count == 0;
+    }
+
+    BoundingBox BoundingBoxSet::get(std::size_t i) const {
+        return {{this->xMin[i], this->yMin[i]}, {this->xMax[i], this->yMax[i]}};
+    }
+
+    std::size_t BoundingBoxSet::mask_words() const {
+        return (this->count + WORD_BITS - 1) / WORD_BITS;
+    }
+
+#if defined(BOXSET_AVX2)
+    const int BOUNDING_BOX_BATCH_WIDTH = 4;
+
+    std::uint64_t BoundingBoxSet::overlap_word(std::size_t first, double qxMin, double qyMin, double qxMax,
+                                               double qyMax) const {
+        auto bxMin = _mm256_set1_pd(qxMin);
+        auto byMin = _mm256_set1_pd(qyMin);
+        auto bxMax = _mm256_set1_pd(qxMax);
+        auto byMax = _mm256_set1_pd(qyMax);
+
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < WORD_BITS; i += 4) {
+            auto j = first + i;
+            auto hit = _mm256_and_pd(
+                    _mm256_and_pd(_mm256_cmp_pd(_mm256_loadu_pd(&this->xMin[j]), bxMax, _CMP_LE_OQ),
+                                  _mm256_cmp_pd(_mm256_loadu_pd(&this->xMax[j]), bxMin, _CMP_GE_OQ)),
+                    _mm256_and_pd(_mm256_cmp_pd(_mm256_loadu_pd(&this->yMin[j]), byMax, _CMP_LE_OQ),
+                                  _mm256_cmp_pd(_mm256_loadu_pd(&this->yMax[j]), byMin, _CMP_GE_OQ)));
+            word |= (std::uint64_t)_mm256_movemask_pd(hit) << i;
+        }
+        return word;
+    }
+
+#elif defined(BOXSET_SSE2)
+    const int BOUNDING_BOX_BATCH_WIDTH = 2;
+
+    std::uint64_t BoundingBoxSet::overlap_word(std::size_t first, double qxMin, double qyMin, double qxMax,
+                                               double qyMax) const {
+        auto bxMin = _mm_set1_pd(qxMin);
+        auto byMin = _mm_set1_pd(qyMin);
+        auto bxMax = _mm_set1_pd(qxMax);
+        auto byMax = _mm_set1_pd(qyMax);
+
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < WORD_BITS; i += 2) {
+            auto j = first + i;
+            auto hit = _mm_and_pd(_mm_and_pd(_mm_cmple_pd(_mm_loadu_pd(&this->xMin[j]), bxMax),
+                                             _mm_cmpge_pd(_mm_loadu_pd(&this->xMax[j]), bxMin)),
+                                  _mm_and_pd(_mm_cmple_pd(_mm_loadu_pd(&this->yMin[j]), byMax),
+                                             _mm_cmpge_pd(_mm_loadu_pd(&this->yMax[j]), byMin)));
+            word |= (std::uint64_t)_mm_movemask_pd(hit) << i;
+        }
+        return word;
+    }
+
+#elif defined(BOXSET_NEON)
+    const int BOUNDING_BOX_BATCH_WIDTH = 2;
+
+    std::uint64_t BoundingBoxSet::overlap_word(std::size_t first, double qxMin, double qyMin, double qxMax,
+                                               double qyMax) const {
+        auto bxMin = vdupq_n_f64(qxMin);
+        auto byMin = vdupq_n_f64(qyMin);
+        auto bxMax = vdupq_n_f64(qxMax);
+        auto byMax = vdupq_n_f64(qyMax);
+
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < WORD_BITS; i += 2) {
+            auto j = first + i;
+            auto hit = vandq_u64(vandq_u64(vcleq_f64(vld1q_f64(&this->xMin[j]), bxMax),
+                                           vcgeq_f64(vld1q_f64(&this->xMax[j]), bxMin)),
+                                 vandq_u64(vcleq_f64(vld1q_f64(&this->yMin[j]), byMax),
+                                           vcgeq_f64(vld1q_f64(&this->yMax[j]), byMin)));
+            word |= ((vgetq_lane_u64(hit, 0) & 1) | (vgetq_lane_u64(hit, 1) & 2)) << i;
+        }
+        return word;
+    }
+
+#else
+    const int BOUNDING_BOX_BATCH_WIDTH = 1;
+
+    std::uint64_t BoundingBoxSet::overlap_word(std::size_t first, double qxMin, double qyMin, double qxMax,
+                                               double qyMax) const {
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < WORD_BITS; ++i) {
+            auto j = first + i;
+            bool hit = this->xMin[j] <= qxMax && this->xMax[j] >= qxMin &&
+                       this->yMin[j] <= qyMax && this->yMax[j] >= qyMin;
+            word |= (std::uint64_t)hit << i;
+        }
+        return word;
+    }
+
+#endif
+
+    void BoundingBoxSet::overlaps(const BoundingBox& box, std::uint64_t* mask) const {
+        const auto& lo = box.get_corner_min();
+        const auto& hi = box.get_corner_max();
+        for (std::size_t w = 0; w < this->mask_words(); ++w)
+            mask[w] = this->overlap_word(w * WORD_BITS, lo.x, lo.y, hi.x, hi.y);
+    }
+
+    std::vector<std::uint64_t> BoundingBoxSet::overlaps(const BoundingBox& box) const {
+        std::vector<std::uint64_t> mask(this->mask_words());
+        this->overlaps(box, mask.data());
+        return mask;
+    }
+
+    void BoundingBoxSet::overlaps(const BoundingBoxSet& queries, std::uint64_t* masks) const {
+        // one query at a time keeps its four bounds in registers while this set streams through the cache
+        auto words = this->mask_words();
+        for (std::size_t j = 0; j < queries.count; ++j) {
+            for (std::size_t w = 0; w < words; ++w)
+                masks[j * words + w] = this->overlap_word(w * WORD_BITS, queries.xMin[j], queries.yMin[j],
+                                                          queries.xMax[j], queries.yMax[j]);
+        }
+    }
+
+    std::vector<std::uint64_t> BoundingBoxSet::overlaps(const BoundingBoxSet& queries) const {
+        std::vector<std::uint64_t> masks(queries.size() * this->mask_words());
+        this->overlaps(queries, masks.data());
+        return masks;
+    }
+
+    bool BoundingBoxSet::any_overlap(const BoundingBox& box) const {
+        const auto& lo = box.get_corner_min();
+        const auto& hi = box.get_corner_max();
+        for (std::size_t w = 0; w < this->mask_words(); ++w) {
+            if (this->overlap_word(w * WORD_BITS, lo.x, lo.y, hi.x, hi.y))
+                return true;
+        }
+        return false;
+    }
+} // path
@@ -0,0 +1,83 @@
+//
+// Created by Benjamin Lee on 9/1/24.
+//
+
+#ifndef VEX_PATH_PLANNER_BOUNDINGBOXSET_H
+#define VEX_PATH_PLANNER_BOUNDINGBOXSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BoundingBox.h"
+
+namespace path {
+    /**
+     * @brief number of boxes tested per instruction by BoundingBoxSet (1 when no SIMD path is compiled in)
+     */
+    extern const int BOUNDING_BOX_BATCH_WIDTH;
+
+    /**
+     * @brief structure-of-arrays set of bounding boxes, tested for overlap in SIMD batches.
+     * Uses AVX2 or SSE2 on x86 and NEON on AArch64, whichever the compiler targets, with a scalar fallback.
+     * Results are bitmasks: bit i % 64 of word i / 64 is set if box i overlaps. Overlap has the same meaning as
+     * BoundingBox::intersects, i.e. boxes that only touch overlap.
+     */
+    class BoundingBoxSet {
+    public:
+        BoundingBoxSet() = default;
+        explicit BoundingBoxSet(const std::vector<BoundingBox>& boxes);
+
+        void push_back(const BoundingBox& box);
+        void clear();
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] BoundingBox get(std::size_t i) const;
+
+        /**
+         * @return number of 64-bit words in the mask of one query
+         */
+        [[nodiscard]] std::size_t mask_words() const;
+
+        /**
+         * @brief test one box against every box in the set
+         * @param box query box
+         * @param mask mask_words() words, overwritten with the overlap bitmask
+         */
+        void overlaps(const BoundingBox& box, std::uint64_t* mask) const;
+
+        [[nodiscard]] std::vector<std::uint64_t> overlaps(const BoundingBox& box) const;
+
+        /**
+         * @brief test every box of another set against every box in this set
+         * @param queries boxes to test
+         * @param masks queries.size() rows of mask_words() words; row j is overwritten with the bitmask of queries[j]
+         */
+        void overlaps(const BoundingBoxSet& queries, std::uint64_t* masks) const;
+
+        [[nodiscard]] std::vector<std::uint64_t> overlaps(const BoundingBoxSet& queries) const;
+
+        /**
+         * @param box query box
+         * @return whether any box in the set overlaps box
+         */
+        [[nodiscard]] bool any_overlap(const BoundingBox& box) const;
+
+    private:
+        /**
+         * @brief overlap bits of boxes [first, first + 64) against a query, padding reading as no overlap
+         */
+        [[nodiscard]] std::uint64_t overlap_word(std::size_t first, double xMin, double yMin, double xMax,
+                                                 double yMax) const;
+
+        // padded to a multiple of 64 with empty boxes (min = +inf, max = -inf) that overlap nothing
+        std::vector<double> xMin;
+        std::vector<double> yMin;
+        std::vector<double> xMax;
+        std::vector<double> yMax;
+        std::size_t count = 0;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_BOUNDINGBOXSET_H
@@ -3,6 +3,7 @@
 //
 
 #include "CircularArc.h"
+#include <algorithm>
 
 namespace path {
     CircularArc::CircularArc(path::Vector2 center, double startAngle, double endAngle, double radius, bool visible):
@@ -18,19 +19,145 @@ namespace path {
             s = this->thetaStart + s / this->radius;
         else
             s = this->thetaStart - s / this->radius;
-        return {this->radius * cos(s), this->radius * sin(s)};
+        return this->center + Vector2(this->radius * cos(s), this->radius * sin(s));
     }
 
-    void CircularArc::get_waypoints(std::vector<path::Vector2>& output, int numWaypoints) const {
-        map_interval<double, Vector2>(output, [this](double t) -> Vector2 {
-            return Vector2(cos(t), sin(t)) * this->radius + this->center;
-        }, this->thetaStart, this->thetaEnd, numWaypoints);
+    void CircularArc::get_waypoints(WaypointBuffer& output, int numWaypoints) const {
+        auto dTheta = numWaypoints > 1 ? (this->thetaEnd - this->thetaStart) / (numWaypoints - 1) : 0;
+        this->rotate_waypoints(output, numWaypoints - 1, dTheta, false);
     }
 
-    void CircularArc::get_waypoints_spaced(std::vector<path::Vector2>& output, double ds) const {
-        map_interval_spaced<double, Vector2>(output, [this](double t) -> Vector2 {
-            return Vector2(cos(t), sin(t)) * this->radius + this->center;
-        }, this->thetaStart, this->thetaEnd, ds / this->radius);
+    void CircularArc::get_waypoints_spaced(WaypointBuffer& output, double ds) const {
+        auto dTheta = ds / this->radius;
+        auto sweep = std::fabs(this->thetaEnd - this->thetaStart);
+        auto steps = (int)(sweep / dTheta);
+        this->rotate_waypoints(output, steps, this->thetaEnd < this->thetaStart ? -dTheta : dTheta,
+                               (sweep - steps * dTheta) * this->radius > 0.001);
+    }
+
+    void CircularArc::get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const {
+        auto ds = chord_step(1 / this->radius, tolerance, dsMax);
+        auto steps = std::max((int)std::ceil(this->radius * std::fabs(this->thetaEnd - this->thetaStart) / ds), 1);
+        this->get_waypoints(output, steps + 1);
+    }
+
+    void CircularArc::rotate_waypoints(WaypointBuffer& output, int steps, double dTheta, bool useEnd) const {
+        auto numAdded = (std::size_t)steps + useEnd + 1;
+        if (output.capacity() - output.size() < numAdded)
+            output.reserve(output.size() + numAdded);
+
+        // travelling counterclockwise the heading leads the polar angle by pi/2 and the curvature is 1/r
+        auto turn = this->thetaEnd < this->thetaStart ? -1.0 : 1.0;
+        auto kappa = turn / this->radius;
+        auto s0 = output.length();
+
+        // (c, s) = (cos theta_k, sin theta_k) advances by the rotation matrix [cos dTheta, -sin dTheta; sin dTheta,
+        // cos dTheta]. Rounding error grows linearly with the number of rotations, so the pair is re-seeded exactly
+        // every ARC_RECURRENCE_RESEED steps.
+        auto cd = std::cos(dTheta);
+        auto sd = std::sin(dTheta);
+        double c = 0;
+        double s = 0;
+
+        for (int k = 0; k <= steps; ++k) {
+            auto theta = this->thetaStart + k * dTheta;
+            if (k % ARC_RECURRENCE_RESEED == 0) {
+                c = std::cos(theta);
+                s = std::sin(theta);
+            } else {
+                auto next = c * cd - s * sd;
+                s = s * cd + c * sd;
+                c = next;
+            }
+            output.push_back({this->center.x + this->radius * c, this->center.y + this->radius * s},
+                             theta + turn * M_PI_2, kappa, s0 + this->radius * std::fabs(k * dTheta));
+        }
+
+        if (useEnd) {
+            output.push_back(Vector2(cos(this->thetaEnd), sin(this->thetaEnd)) * this->radius + this->center,
+                             this->thetaEnd + turn * M_PI_2, kappa,
+                             s0 + this->radius * std::fabs(this->thetaEnd - this->thetaStart));
+        }
+    }
+
+    double CircularArc::get_heading(double s) const {
+        auto turn = this->thetaEnd < this->thetaStart ? -1.0 : 1.0;
+        return this->thetaStart + turn * (s / this->radius + M_PI_2);
+    }
+
+    double CircularArc::get_curvature(double) const {
+        return (this->thetaEnd < this->thetaStart ? -1.0 : 1.0) / this->radius;
+    }
+
+    Projection CircularArc::project(Vector2 p) const {
+        auto offset = p - this->center;
+        auto turn = this->thetaEnd < this->thetaStart ? -1.0 : 1.0;
+        auto sweep = std::fabs(this->thetaEnd - this->thetaStart);
+
+        // angle swept from the start to the polar angle of p, in [0, 2 pi)
+        auto swept = offset.norm_squared() == 0 ? 0 : std::fmod(turn * (offset.heading() - this->thetaStart), 2 * M_PI);
+        if (swept < 0)
+            swept += 2 * M_PI;
+
+        double s;
+        if (swept <= sweep) {
+            s = this->radius * swept;
+        } else {
+            auto toStart = (p - this->get_point(0)).norm();
+            auto toEnd = (p - this->get_point(this->radius * sweep)).norm();
+            s = toStart < toEnd ? 0 : this->radius * sweep;
+        }
+        auto point = this->get_point(s);
+        return {s, point, (p - point).norm()};
+    }
+
+    bool CircularArc::intersect_circle(Vector2 center, double radius, double sMin, double& s) const {
+        auto offset = center - this->center;
+        auto d = offset.norm();
+        if (d == 0 || d > this->radius + radius || d < std::fabs(this->radius - radius))
+            return false;
+
+        // the intersections are at +-alpha from the direction of the other center, by the law of cosines
+        auto alpha = std::acos(std::clamp((this->radius * this->radius + d * d - radius * radius) /
+                                          (2 * this->radius * d), -1.0, 1.0));
+        auto turn = this->thetaEnd < this->thetaStart ? -1.0 : 1.0;
+        auto sweep = std::fabs(this->thetaEnd - this->thetaStart);
+
+        bool found = false;
+        for (auto angle: {offset.heading() - alpha, offset.heading() + alpha}) {
+            auto swept = std::fmod(turn * (angle - this->thetaStart), 2 * M_PI);
+            if (swept < 0)
+                swept += 2 * M_PI;
+            // the sweep can exceed a full turn, so try every lap
+            for (; swept <= sweep; swept += 2 * M_PI) {
+                auto t = this->radius * swept;
+                if (t >= sMin && (!found || t < s)) {
+                    s = t;
+                    found = true;
+                    break;
+                }
+            }
+        }
+        return found;
+    }
+
+    BoundingBox CircularArc::get_bounding_box(double s0, double s1) const {
+        auto length = std::fabs(this->radius * (this->thetaEnd - this->thetaStart));
+        s0 = std::clamp(s0, 0.0, length);
+        s1 = std::clamp(s1, 0.0, length);
+
+        BoundingBox box(this->get_point(s0));
+        box.expand(this->get_point(s1));
+
+        // polar angles covered by the part
+        auto turn = this->thetaEnd < this->thetaStart ? -1.0 : 1.0;
+        auto a = this->thetaStart + turn * s0 / this->radius;
+        auto b = this->thetaStart + turn * s1 / this->radius;
+        auto lo = std::fmin(a, b);
+        auto hi = std::fmax(a, b);
+        for (auto k = std::ceil(lo / M_PI_2); k * M_PI_2 <= hi; ++k)
+            box.expand(this->center + Vector2(std::cos(k * M_PI_2), std::sin(k * M_PI_2)) * this->radius);
+        return box;
     }
 
     Vector2 CircularArc::get_center() const {
@@ -56,22 +183,27 @@ namespace path {
     }
 
     void CircularArc::set_center(path::Vector2 pos) {
+        this->invalidate_cache();
         this->center = pos;
     }
 
     void CircularArc::set_start_angle(double theta) {
+        this->invalidate_cache();
         this->thetaStart = theta;
     }
 
     void CircularArc::set_end_angle(double theta) {
+        this->invalidate_cache();
         this->thetaEnd = theta;
     }
 
     void CircularArc::set_radius(double r) {
+        this->invalidate_cache();
         this->radius = r;
     }
 
     void CircularArc::configure(path::Vector2 center, double startAngle, double endAngle, double r) {
+        this->invalidate_cache();
         this->center = center;
         this->thetaStart = startAngle;
         this->thetaEnd = endAngle;
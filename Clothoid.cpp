@@ -3,7 +3,9 @@
 //
 
 #include "Clothoid.h"
-#include "Fresnel.h"
+#include "SinCos.h"
+#include <algorithm>
+#include <limits>
 
 namespace path {
 
@@ -15,86 +17,352 @@ namespace path {
             kappa0(initialCurvature),
             theta0(initialHeading),
             p0(initialPosition),
-            reversed(reversed) {}
+            reversed(reversed),
+            form(initialPosition, initialHeading, initialCurvature, sharpness / 2, length) {}
 
     Vector2 Clothoid::get_point(double t) const {
-        auto scale = sqrt(this->sigma_2 / M_PI_2);
-        if (kappa0 == 0 && t * scale <= 1) {
-            // use fresnel table
-            t *= scale;
-
-            auto lerpTime = t * FRESNEL_TABLE_SIZE;
-            auto index = (int) lerpTime;
-            lerpTime -= index;
-
-            if (index + 1 < FRESNEL_TABLE_SIZE) {
-                return this->p0 + lerp<double, Vector2>(FRESNEL_TABLE[index], FRESNEL_TABLE[index + 1],
-                                                                lerpTime).rotate(this->theta0) / scale;
+        return this->form.get_point(t);
+    }
+
+    Vector2 Clothoid::get_travel_point(double s) const {
+        return this->get_point(this->reversed ? this->s - s : s);
+    }
+
+    // integrand samples per sincos_batch call. Must be even so Simpson pairs never straddle two chunks.
+    static constexpr int SAMPLE_CHUNK = 256;
+
+    void Clothoid::integrate_waypoints(WaypointBuffer& output, int steps, double ds) const {
+        auto remainder = this->s - steps * ds;
+        bool useEnd = remainder > 0.001;
+        auto first = output.size();
+
+        auto numAdded = (std::size_t)steps + useEnd + 1;
+        if (output.capacity() - output.size() < numAdded)
+            output.reserve(output.size() + numAdded);
+
+        // waypoints are generated from p0 and flipped afterwards if reversed, so heading, curvature and arc length
+        // are converted to the direction of travel as they are emitted
+        auto s0 = output.length();
+        auto headingOffset = this->reversed ? M_PI : 0;
+        auto curvatureSign = this->reversed ? -1 : 1;
+
+        // a fixed buffer too small for a reversed clothoid keeps the points nearest the start of travel, which are
+        // generated last
+        std::size_t skip = 0;
+        std::size_t needed = steps + useEnd + 1;
+        if (this->reversed && output.is_fixed() && output.capacity() - output.size() < needed) {
+            skip = needed - (output.capacity() - output.size());
+            output.mark_truncated();
+        }
+
+        auto emit = [&](Vector2 pos, double x, double theta) {
+            if (skip > 0) {
+                --skip;
+                return;
+            }
+            output.push_back(pos, theta + headingOffset, curvatureSign * (2 * this->sigma_2 * x + this->kappa0),
+                             s0 + (this->reversed ? this->s - x : x));
+        };
+        emit(this->p0, 0, this->theta0);
+
+        // Simpson's rule over each step [k ds, (k+1) ds], sampling the heading at every half step
+        double angle[SAMPLE_CHUNK];
+        double sinTheta[SAMPLE_CHUNK];
+        double cosTheta[SAMPLE_CHUNK];
+        auto halfStep = ds / 2;
+        auto weight = ds / 6;
+        auto sum = this->p0;
+        Vector2 prev = {std::cos(this->theta0), std::sin(this->theta0)};
+
+        for (int j0 = 1; j0 <= 2 * steps; j0 += SAMPLE_CHUNK) {
+            auto n = std::min(SAMPLE_CHUNK, 2 * steps - j0 + 1);
+            for (int i = 0; i < n; ++i) {
+                auto x = (j0 + i) * halfStep;
+                angle[i] = (this->sigma_2 * x + this->kappa0) * x + this->theta0;
+            }
+            sincos_batch(angle, sinTheta, cosTheta, n);
+
+            for (int i = 0; i + 1 < n; i += 2) {
+                sum.x += (prev.x + 4 * cosTheta[i] + cosTheta[i + 1]) * weight;
+                sum.y += (prev.y + 4 * sinTheta[i] + sinTheta[i + 1]) * weight;
+                prev = {cosTheta[i + 1], sinTheta[i + 1]};
+                emit(sum, (j0 + i + 1) * halfStep, angle[i + 1]);
             }
-            return this->p0 + scale * FRESNEL_TABLE[index].rotate(this->theta0);
         }
 
-        return this->p0 + integral<double, Vector2>(
-                    [this](double x) -> Vector2 {
-                        return {std::cos(this->sigma_2 * x * x + this->kappa0 * x + this->theta0),
-                                std::sin(this->sigma_2 * x * x + this->kappa0 * x + this->theta0)};
-                    }, 0, this->s, std::max((int)(this->s * 10), 10));
-    }
-
-    void Clothoid::get_waypoints(std::vector<path::Vector2>& output, int numWaypoints) const {
-        auto sz = (long)output.size();
-        if (kappa0 == 0) {
-            // a slight optimization
-            moving_integral<double, Vector2>(
-                    output,
-                    [this](double x) -> Vector2 {
-                        return {
-                                std::cos(this->sigma_2 * x * x + this->theta0),
-                                std::sin(this->sigma_2 * x * x + this->theta0)
-                        };
-                    }, 0, this->s, numWaypoints, this->p0);
-        } else {
-            moving_integral<double, Vector2>(
-                    output,
-                    [this](double x) -> Vector2 {
-                        return {
-                                std::cos(this->sigma_2 * x * x + this->kappa0 * x + this->theta0),
-                                std::sin(this->sigma_2 * x * x + this->kappa0 * x + this->theta0)
-                        };
-                    }, 0, this->s, numWaypoints, this->p0);
+        if (useEnd) {
+            // use a smaller window for the last point
+            auto mid = this->s - remainder / 2;
+            auto thetaMid = (this->sigma_2 * mid + this->kappa0) * mid + this->theta0;
+            auto thetaEnd = (this->sigma_2 * this->s + this->kappa0) * this->s + this->theta0;
+            sum.x += (prev.x + 4 * std::cos(thetaMid) + std::cos(thetaEnd)) * remainder / 6;
+            sum.y += (prev.y + 4 * std::sin(thetaMid) + std::sin(thetaEnd)) * remainder / 6;
+            emit(sum, this->s, thetaEnd);
         }
 
         if (this->reversed)
-            std::reverse(output.begin() + sz, output.end());
-    }
-
-    void
-    Clothoid::get_waypoints_spaced(std::vector<Vector2>& output, double ds) const {
-        auto sz = (long)output.size();
-
-        if (kappa0 == 0) {
-            // a slight optimization
-            moving_integral_spaced<double, Vector2>(
-                    output,
-                    [this](double x) -> Vector2 {
-                        return {
-                                std::cos(this->sigma_2 * x * x + this->theta0),
-                                std::sin(this->sigma_2 * x * x + this->theta0)
-                        };
-                    }, 0, this->s, ds, this->p0);
-        } else {
-            moving_integral_spaced<double, Vector2>(
-                    output,
-                    [this](double x) -> Vector2 {
-                        return {
-                                std::cos(this->sigma_2 * x * x + this->kappa0 * x + this->theta0),
-                                std::sin(this->sigma_2 * x * x + this->kappa0 * x + this->theta0)
-                        };
-                    }, 0, this->s, ds, this->p0);
+            output.reverse_from(first);
+    }
+
+    void Clothoid::get_waypoints(WaypointBuffer& output, int numWaypoints) const {
+        auto steps = std::max(numWaypoints - 1, 1);
+        this->integrate_waypoints(output, steps, this->s / steps);
+    }
+
+    void Clothoid::get_waypoints_spaced(WaypointBuffer& output, double ds) const {
+        this->integrate_waypoints(output, (int)(this->s / ds), ds);
+    }
+
+    void Clothoid::get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const {
+        // walk in the direction of travel so a full fixed buffer keeps the start of the clothoid
+        auto s0 = output.length();
+        auto headingOffset = this->reversed ? M_PI : 0;
+        auto curvatureSign = this->reversed ? -1 : 1;
+        auto direction = this->reversed ? -1.0 : 1.0;
+
+        auto curvature = [this](double x) { return 2 * this->sigma_2 * x + this->kappa0; };
+        auto emit = [&](double x, double travelled) {
+            output.push_back(x == 0 ? this->p0 : this->get_point(x),
+                             (this->sigma_2 * x + this->kappa0) * x + this->theta0 + headingOffset,
+                             curvatureSign * curvature(x), s0 + travelled);
+        };
+
+        double travelled = 0;
+        auto x = this->reversed ? this->s : 0;
+        emit(x, 0);
+        while (this->s - travelled > 1e-9) {
+            // curvature is linear in x, so its largest magnitude over a step is at one of the ends
+            auto ds = chord_step(curvature(x), tolerance, dsMax);
+            ds = chord_step(std::fmax(std::fabs(curvature(x)), std::fabs(curvature(x + direction * ds))),
+                            tolerance, dsMax);
+            ds = std::fmin(ds, this->s - travelled);
+            travelled += ds;
+            x = this->reversed ? this->s - travelled : travelled;
+            emit(x, travelled);
         }
+    }
 
-        if (this->reversed)
-            std::reverse(output.begin() + sz, output.end());
+    double Clothoid::get_heading(double s) const {
+        auto x = this->reversed ? this->s - s : s;
+        return (this->sigma_2 * x + this->kappa0) * x + this->theta0 + (this->reversed ? M_PI : 0);
+    }
+
+    double Clothoid::get_curvature(double s) const {
+        auto x = this->reversed ? this->s - s : s;
+        return (this->reversed ? -1 : 1) * (2 * this->sigma_2 * x + this->kappa0);
+    }
+
+    double Clothoid::get_turn(double x0, double x1) const {
+        // |kappa| is linear in x apart from where kappa changes sign, which leaves two triangles
+        auto k0 = 2 * this->sigma_2 * x0 + this->kappa0;
+        auto k1 = 2 * this->sigma_2 * x1 + this->kappa0;
+        if (k0 * k1 >= 0)
+            return std::fabs(k0 + k1) / 2 * (x1 - x0);
+        return (k0 * k0 + k1 * k1) / (4 * std::fabs(this->sigma_2));
+    }
+
+    // fewest samples used to bracket the closest point before refining it
+    static constexpr int PROJECTION_SAMPLES = 8;
+    // largest heading change between samples, so that a bracket cannot hide a local minimum between its ends
+    static constexpr double PROJECTION_MAX_TURN = M_PI_4;
+
+    Projection Clothoid::project(Vector2 p) const {
+        // work in the parameter x measured from p0 and convert to the direction of travel at the end
+        auto samples = std::max(PROJECTION_SAMPLES,
+                                (int)std::ceil(this->get_turn(0, this->s) / PROJECTION_MAX_TURN));
+        auto dx = this->s / samples;
+
+        // g(x) = (P(x) - p) . T(x) vanishes at the closest interior point, g'(x) = 1 + kappa(x) (P(x) - p) . N(x)
+        auto g = [&](double t, double& slope) {
+            auto theta = (this->sigma_2 * t + this->kappa0) * t + this->theta0;
+            auto tangent = Vector2(std::cos(theta), std::sin(theta));
+            auto offset = this->get_point(t) - p;
+            slope = 1 + (2 * this->sigma_2 * t + this->kappa0) * tangent.cross(offset);
+            return offset.dot(tangent);
+        };
+        auto distance = [&](double t) { return (this->get_point(t) - p).norm_squared(); };
+
+        // safeguarded Newton on g inside [lo, hi], starting from the sample x
+        auto refine = [&](double lo, double hi, double x) {
+            double slope;
+            auto gLo = g(lo, slope);
+            auto gHi = g(hi, slope);
+            if (!(gLo < 0 && gHi > 0)) {
+                // no sign change: the closest point of the bracket is one of the points sampled
+                auto dLo = distance(lo);
+                auto dHi = distance(hi);
+                auto dX = distance(x);
+                return dX <= dLo && dX <= dHi ? x : dLo < dHi ? lo : hi;
+            }
+            for (int iter = 0; iter < 50; ++iter) {
+                auto value = g(x, slope);
+                if (value < 0)
+                    lo = x;
+                else
+                    hi = x;
+
+                auto next = x - value / slope;
+                if (!(slope > 0) || next <= lo || next >= hi)
+                    next = (lo + hi) / 2;
+                if (std::fabs(next - x) < 1e-12)
+                    return next;
+                x = next;
+            }
+            return x;
+        };
+
+        // refine around every local minimum of the sampled distance and keep the closest result
+        auto infinity = std::numeric_limits<double>::infinity();
+        auto bestX = 0.0;
+        auto bestDistance = infinity;
+        auto dPrev = infinity;
+        auto dCur = distance(0);
+        for (int i = 0; i <= samples; ++i) {
+            auto dNext = i < samples ? distance((i + 1) * dx) : infinity;
+            if (dCur <= dPrev && dCur <= dNext) {
+                auto x = refine(std::fmax(0.0, (i - 1) * dx), std::fmin(this->s, (i + 1) * dx), i * dx);
+                auto d = distance(x);
+                if (d < bestDistance) {
+                    bestX = x;
+                    bestDistance = d;
+                }
+            }
+            dPrev = dCur;
+            dCur = dNext;
+        }
+
+        auto point = this->get_point(bestX);
+        return {this->reversed ? this->s - bestX : bestX, point, (point - p).norm()};
+    }
+
+    bool Clothoid::intersect_circle(Vector2 center, double radius, double sMin, double& s) const {
+        auto f = [&](double t) {
+            return (this->get_travel_point(t) - center).norm_squared() - radius * radius;
+        };
+        // f' = 2 (P - c) . T
+        auto df = [&](double t) {
+            auto heading = this->get_heading(t);
+            return 2 * (this->get_travel_point(t) - center).dot({std::cos(heading), std::sin(heading)});
+        };
+        if (sMin > this->s)
+            return false;
+
+        // the curve turns by at most a quarter radian per step, so it cannot swing through the circle and back unseen
+        auto step = std::fmin(this->s / PROJECTION_SAMPLES, radius / 4);
+        auto kappaMax = std::fmax(std::fabs(this->get_curvature(sMin)), std::fabs(this->get_curvature(this->s)));
+        if (kappaMax > 0)
+            step = std::fmin(step, 1 / (4 * kappaMax));
+
+        auto a = sMin;
+        auto fa = f(a);
+        auto dfa = df(a);
+        if (fa == 0) {
+            s = a;
+            return true;
+        }
+
+        while (a < this->s) {
+            auto b = std::fmin(a + step, this->s);
+            auto fb = f(b);
+            auto dfb = df(b);
+            if ((fa < 0) == (fb < 0) && fb != 0 && (dfa < 0) != (dfb < 0)) {
+                // f turns back within the step and may touch zero in between: bisect f' for the turning point and
+                // look there
+                auto lo = a;
+                auto hi = b;
+                for (int iter = 0; iter < 60 && hi - lo > 1e-12; ++iter) {
+                    auto mid = (lo + hi) / 2;
+                    if ((df(mid) < 0) == (dfa < 0))
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+                auto m = (lo + hi) / 2;
+                auto fm = f(m);
+                if ((fm < 0) != (fa < 0) || fm == 0) {
+                    b = m;
+                    fb = fm;
+                }
+            }
+
+            if ((fa < 0) != (fb < 0) || fb == 0) {
+                // Illinois: halve the weight of an endpoint that is kept twice in a row
+                int side = 0;
+                for (int iter = 0; iter < 60 && b - a > 1e-12; ++iter) {
+                    auto c = (a * fb - b * fa) / (fb - fa);
+                    auto fc = f(c);
+                    if (fc == 0) {
+                        a = b = c;
+                        break;
+                    }
+                    if ((fc < 0) == (fa < 0)) {
+                        a = c;
+                        fa = fc;
+                        if (side == -1)
+                            fb /= 2;
+                        side = -1;
+                    } else {
+                        b = c;
+                        fb = fc;
+                        if (side == 1)
+                            fa /= 2;
+                        side = 1;
+                    }
+                }
+                s = (a + b) / 2;
+                return true;
+            }
+            a = b;
+            fa = fb;
+            dfa = dfb;
+        }
+        return false;
+    }
+
+    BoundingBox Clothoid::get_bounding_box(double s0, double s1) const {
+        s0 = std::clamp(s0, 0.0, this->s);
+        s1 = std::clamp(s1, 0.0, this->s);
+        // geometric parameters of the part, measured from p0
+        auto x0 = this->reversed ? this->s - s1 : s0;
+        auto x1 = this->reversed ? this->s - s0 : s1;
+
+        BoundingBox box(this->get_point(x0));
+        box.expand(this->get_point(x1));
+
+        // range of the heading over [x0, x1]: the ends, or the vertex of the quadratic if it lies inside
+        auto theta = [this](double x) { return (this->sigma_2 * x + this->kappa0) * x + this->theta0; };
+        auto lo = std::fmin(theta(x0), theta(x1));
+        auto hi = std::fmax(theta(x0), theta(x1));
+        if (this->sigma_2 != 0) {
+            auto vertex = -this->kappa0 / (2 * this->sigma_2);
+            if (vertex > x0 && vertex < x1) {
+                lo = std::fmin(lo, theta(vertex));
+                hi = std::fmax(hi, theta(vertex));
+            }
+        }
+
+        // every x or y extremum has a heading that is a multiple of pi/2; solve sigma_2 x^2 + kappa0 x + theta0 = target
+        for (auto k = std::ceil(lo / M_PI_2); k * M_PI_2 <= hi; ++k) {
+            auto c = this->theta0 - k * M_PI_2;
+            if (this->sigma_2 == 0) {
+                if (this->kappa0 != 0) {
+                    auto x = -c / this->kappa0;
+                    if (x >= x0 && x <= x1)
+                        box.expand(this->get_point(x));
+                }
+                continue;
+            }
+
+            auto discriminant = this->kappa0 * this->kappa0 - 4 * this->sigma_2 * c;
+            if (discriminant < 0)
+                continue;
+            auto root = std::sqrt(discriminant);
+            for (auto x: {(-this->kappa0 - root) / (2 * this->sigma_2), (-this->kappa0 + root) / (2 * this->sigma_2)}) {
+                if (x >= x0 && x <= x1)
+                    box.expand(this->get_point(x));
+            }
+        }
+        return box;
     }
 
     double Clothoid::get_initial_curvature() const {
@@ -117,33 +385,53 @@ namespace path {
         return this->p0;
     }
 
+    bool Clothoid::is_reversed() const {
+        return this->reversed;
+    }
+
+    void Clothoid::update_form() {
+        this->form = ClothoidForm<double>(this->p0, this->theta0, this->kappa0, this->sigma_2, this->s);
+    }
+
     void Clothoid::set_initial_curvature(double curvature) {
+        this->invalidate_cache();
         this->kappa0 = curvature;
+        this->update_form();
     }
 
     void Clothoid::set_initial_heading(double heading) {
+        this->invalidate_cache();
         this->theta0 = heading;
+        this->update_form();
     }
 
     void Clothoid::set_length(double length) {
+        this->invalidate_cache();
         this->s = length;
+        this->update_form();
     }
 
     void Clothoid::set_sharpness(double sharpness) {
+        this->invalidate_cache();
         this->sigma_2 = sharpness / 2;
+        this->update_form();
     }
 
     void Clothoid::set_initial_position(path::Vector2 position) {
+        this->invalidate_cache();
         this->p0 = position;
+        this->update_form();
     }
 
     void Clothoid::configure(path::Vector2 initialPosition, double initialHeading, double length, double sharpness,
                              double initialCurvature, bool reversed) {
+        this->invalidate_cache();
         this->s = length;
         this->p0 = initialPosition;
         this->theta0 = initialHeading;
         this->sigma_2 = sharpness / 2;
         this->kappa0 = initialCurvature;
         this->reversed = reversed;
+        this->update_form();
     }
 } // namespace path
\ No newline at end of file
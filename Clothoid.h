@@ -8,6 +8,7 @@
 #include <vector>
 #include "MathUtils.h"
 #include "Curve.h"
+#include "ClothoidForm.h"
 
 namespace path {
     /**
@@ -36,22 +37,93 @@ namespace path {
         [[nodiscard]] Vector2 get_point(double t) const override;
 
         /**
+         * @brief get point at arc length t by integrating the unit tangent numerically.
+         * get_point(t) is exact and cheaper; this trades accuracy for evaluations, e.g. to validate it.
+         * @tparam Quadrature quadrature policy such as GaussLegendre<N>, AdaptiveSimpson or SimpsonQuadrature
+         * @param t arc length from the initial position
+         * @param quadrature quadrature settings
+         * @return a point on the clothoid
+         */
+        template <typename Quadrature>
+        [[nodiscard]] Vector2 get_point(double t, const Quadrature& quadrature) const {
+            auto tangent = [this](double x) {
+                auto theta = (this->sigma_2 * x + this->kappa0) * x + this->theta0;
+                return Vector2(std::cos(theta), std::sin(theta));
+            };
+            return this->p0 + quadrature.template integrate<double, Vector2>(tangent, 0.0, t);
+        }
+
+        /**
+         * @param s arc length along the direction of travel, i.e. from the end if reversed
+         * @return a point on the clothoid
+         */
+        [[nodiscard]] Vector2 get_travel_point(double s) const override;
+
+        using Curve::get_waypoints;
+        using Curve::get_waypoints_spaced;
+
+        /**
+         * @param output buffer to add waypoints to
          * @param numWaypoints number of waypoints
-         * @return list of waypoints
          */
-        void get_waypoints(std::vector<path::Vector2>& output, int numWaypoints) const override;
+        void get_waypoints(WaypointBuffer& output, int numWaypoints) const override;
 
         /**
+         * @param output buffer to add waypoints to
          * @param ds step size
-         * @return list of waypoints
          */
-        void get_waypoints_spaced(std::vector<path::Vector2>& output, double ds) const override;
+        void get_waypoints_spaced(WaypointBuffer& output, double ds) const override;
+
+        /**
+         * @brief waypoints spaced by the local curvature: each step is sized for the larger curvature at its two ends,
+         * so points bunch up where the clothoid tightens. Positions are exact (Fresnel integrals), not integrated.
+         * @param output buffer to add waypoints to
+         * @param tolerance maximum chord deviation
+         * @param dsMax maximum space between waypoints
+         */
+        void get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const override;
 
         [[nodiscard]] double get_length() const override;
+
+        [[nodiscard]] double get_heading(double s) const override;
+        [[nodiscard]] double get_curvature(double s) const override;
+
+        /**
+         * @brief project onto the clothoid with Newton's method on the tangential offset (p - P(x)) . T(x), whose
+         * derivative follows from the analytic curvature. Started from the nearest of a few samples and kept inside
+         * their bracket, falling back to bisection when a Newton step leaves it.
+         * @param p query point
+         * @return closest point. s is measured along the direction of travel, i.e. from the end if reversed.
+         */
+        [[nodiscard]] Projection project(Vector2 p) const override;
+
+        /**
+         * @brief first crossing of |P(s) - center| = radius. Steps forward until the sign of |P(s) - center|^2 - radius^2
+         * changes, then refines the bracket with the Illinois variant of regula falsi. Steps are at most radius/4
+         * long, so only intersections that touch the circle for less than that can be missed.
+         * @param center center of the circle
+         * @param radius radius of the circle
+         * @param sMin arc length to start searching from
+         * @param s set to the arc length of the intersection, if any
+         * @return whether the curve meets the circle at or after sMin
+         */
+        bool intersect_circle(Vector2 center, double radius, double sMin, double& s) const override;
+
+        using Curve::get_bounding_box;
+
+        /**
+         * @brief box around the end points of the part and its extreme points. x is extreme where the heading is
+         * pi/2 + k pi and y where it is k pi; the heading is quadratic in arc length, so each is a root of a quadratic.
+         * @param s0 arc length along the direction of travel where the part starts
+         * @param s1 arc length along the direction of travel where the part ends
+         * @return bounding box of the part
+         */
+        [[nodiscard]] BoundingBox get_bounding_box(double s0, double s1) const override;
         [[nodiscard]] double get_sharpness() const;
         [[nodiscard]] double get_initial_curvature() const;
         [[nodiscard]] double get_initial_heading() const;
         [[nodiscard]] Vector2 get_initial_position() const;
+        [[nodiscard]] bool is_reversed() const;
 
         void set_length(double length);
         void set_sharpness(double sharpness);
@@ -62,6 +134,24 @@ namespace path {
                        double sharpness = M_PI, double initialCurvature = 0, bool reversed = false);
 
     private:
+        /**
+         * @brief total heading change, the integral of |curvature|, between two geometric parameters x0 <= x1
+         */
+        [[nodiscard]] double get_turn(double x0, double x1) const;
+
+        /**
+         * @brief integrate the heading with Simpson's rule, evaluating the integrand in SIMD batches
+         * @param output buffer to add waypoints to
+         * @param steps number of full steps
+         * @param ds step size. A shorter final step is added if the length is not a multiple of ds.
+         */
+        void integrate_waypoints(WaypointBuffer& output, int steps, double ds) const;
+
+        /**
+         * @brief rebuild form from the parameters below; every mutator calls this
+         */
+        void update_form();
+
         double s;
         double sigma_2;  // sharpness
         double kappa0; // initial maxCurvature
@@ -69,6 +159,8 @@ namespace path {
         Vector2 p0;     // initial position
 
         bool reversed;
+
+        ClothoidForm<double> form; // closed form behind get_point
     };
 
 } // path
@@ -0,0 +1,108 @@
+//
+// Created by Benjamin Lee on 9/5/24.
+//
+
+#include "ClothoidForm.h"
+#include "Fresnel.h"
+#include "MathUtils.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace path {
+    /**
+     * @brief largest |sigma_2| L / |kappa0| evaluated as a sum of arcs, each with a first-order correction. Below it
+     * the Fresnel form subtracts nearly equal values far out on the spiral; in the narrower types that cancellation,
+     * and for Fixed the resolution of the scale, costs far more than in double, so they switch at a larger ratio.
+     */
+    template <typename T>
+    static constexpr double arc_threshold() {
+        if (std::is_same_v<T, double>)
+            return 1e-6;
+        if (std::is_same_v<T, float>)
+            return 0.1;
+        return 1;
+    }
+
+    /**
+     * @brief bound on the first-order correction's error over the whole length, about sigma_2^2 l^4 L / 10 for pieces
+     * of length l, below the resolution of T
+     */
+    template <typename T>
+    static constexpr double arc_tolerance() {
+        if (std::is_same_v<T, double>)
+            return 1e-12;
+        if (std::is_same_v<T, float>)
+            return 1e-7;
+        return 1e-5;
+    }
+
+    static constexpr int MAX_ARC_PIECES = 64;
+
+    template <typename T>
+    ClothoidForm<T>::ClothoidForm(BasicVector2<T> p0, T theta0, T kappa0, T sigma2, T length) :
+            p0(p0), theta0(theta0), kappa0(kappa0), sigma_2(sigma2), length(length), pieces(0), dir(1), h(0), phi(0),
+            scale(0), fresnelStart(0, 0) {
+        using std::sqrt, std::fabs;
+        if (fabs(this->sigma_2) * fabs(this->length) <= T(arc_threshold<T>()) * fabs(this->kappa0)) {
+            // double the pieces until the correction's error is negligible. Checking sigma_2 l^2 < 1 first keeps the
+            // estimate in range for Fixed
+            for (this->pieces = 1; this->pieces < MAX_ARC_PIECES; this->pieces *= 2) {
+                auto l = fabs(this->length) / this->pieces;
+                auto e = fabs(this->sigma_2) * l * l;
+                if (e < 1 && e * e * fabs(this->length) / 10 <= T(arc_tolerance<T>()))
+                    break;
+            }
+            return;
+        }
+
+        // theta(x) = sigma_2 x^2 + kappa0 x + theta0. Mirror the heading so the quadratic term is positive, then
+        // complete the square: theta(x) = a (x + h)^2 + phi, which maps onto the standard Fresnel spiral through
+        // u = scale (x + h) with scale = sqrt(2a / pi). Everything that does not depend on x is computed once.
+        this->dir = sign<T>(this->sigma_2);
+        auto a = this->sigma_2 * this->dir;
+        this->h = this->kappa0 * this->dir / (2 * a);
+        this->phi = this->theta0 * this->dir - a * this->h * this->h;
+        this->scale = sqrt(a / T(M_PI_2));
+        this->fresnelStart = fresnel_vec(this->scale * this->h);
+    }
+
+    template <typename T>
+    BasicVector2<T> ClothoidForm<T>::get_point(T x) const {
+        using std::fabs;
+        if (this->pieces > 0) {
+            // as many pieces over [0, x] as over the same share of the length, each an arc through the heading and
+            // curvature at its start plus sigma_2 int_0^l v^2 i e^(i theta_arc(v)) dv
+            int n = 1;
+            if (this->length != 0)
+                n = std::max(1, (int)(T(this->pieces) * fabs(x) / fabs(this->length) + T(0.999)));
+            auto l = x / T(n);
+            BasicVector2<T> delta = {0, 0};
+            for (int i = 0; i < n; ++i) {
+                auto v = l * T(i);
+                auto u = this->get_curvature(v) * l;
+                delta += arc_chord(u).rotate(this->get_heading(v)) * l;
+                if (this->sigma_2 != 0)
+                    delta += arc_moment(u).rotate(this->get_heading(v) + T(M_PI_2)) * (this->sigma_2 * l * l * l);
+            }
+            return this->p0 + delta;
+        }
+
+        auto delta = (fresnel_vec(this->scale * (x + this->h)) - this->fresnelStart).rotate(this->phi) / this->scale;
+        delta.y *= this->dir;
+        return this->p0 + delta;
+    }
+
+    template <typename T>
+    T ClothoidForm<T>::get_heading(T x) const {
+        return (this->sigma_2 * x + this->kappa0) * x + this->theta0;
+    }
+
+    template <typename T>
+    T ClothoidForm<T>::get_curvature(T x) const {
+        return 2 * this->sigma_2 * x + this->kappa0;
+    }
+
+    template class ClothoidForm<double>;
+    template class ClothoidForm<float>;
+    template class ClothoidForm<Fixed>;
+} // path
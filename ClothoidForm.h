@@ -0,0 +1,64 @@
+//
+// Created by Benjamin Lee on 9/5/24.
+//
+
+#ifndef VEX_PATH_PLANNER_CLOTHOIDFORM_H
+#define VEX_PATH_PLANNER_CLOTHOIDFORM_H
+
+#include "Vector2.h"
+#include "Fixed.h"
+
+namespace path {
+    /**
+     * @brief closed form of a clothoid's position, heading and curvature in a scalar type T: double, float or Fixed.
+     * The clothoid is parametrized by the arc length x from its initial position, with heading
+     * theta(x) = sigma_2 x^2 + kappa0 x + theta0. Shared by Clothoid and BasicClothoid, which map their own arc
+     * lengths onto x. Member functions are defined in ClothoidForm.cpp and instantiated there for those three types.
+     */
+    template <typename T>
+    class ClothoidForm {
+    public:
+        /**
+         * @param p0 initial position
+         * @param theta0 initial heading
+         * @param kappa0 initial curvature
+         * @param sigma2 half the sharpness
+         * @param length arc length the form is evaluated over; sets how finely the arc fallback is split
+         */
+        ClothoidForm(BasicVector2<T> p0, T theta0, T kappa0, T sigma2, T length);
+
+        /**
+         * @param x arc length from the initial position
+         * @return point at x, through the Fresnel integrals, or as a few arcs when the curvature barely changes
+         */
+        [[nodiscard]] BasicVector2<T> get_point(T x) const;
+
+        [[nodiscard]] T get_heading(T x) const;
+        [[nodiscard]] T get_curvature(T x) const;
+
+    private:
+        BasicVector2<T> p0;
+        T theta0;
+        T kappa0;
+        T sigma_2;
+        T length;
+
+        // nearly constant curvature: get_point sums this many arcs or lines per length, each with a first-order
+        // correction. 0 when the Fresnel form is used instead
+        int pieces;
+
+        // otherwise get_point is p0 + (F(scale (x + h)) - F(scale h)) rotated by phi / scale
+        T dir;
+        T h;
+        T phi;
+        T scale;
+        BasicVector2<T> fresnelStart;
+    };
+
+    extern template class ClothoidForm<double>;
+    extern template class ClothoidForm<float>;
+    extern template class ClothoidForm<Fixed>;
+
+} // path
+
+#endif //VEX_PATH_PLANNER_CLOTHOIDFORM_H
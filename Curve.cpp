@@ -8,10 +8,24 @@ namespace path {
     Curve::Curve(bool visible) :
             visible(visible) {}
 
+    Curve::Curve(const Curve& other) :
+            visible(other.visible),
+            cache(std::atomic_load(&other.cache)) {}
+
+    Curve& Curve::operator=(const Curve& other) {
+        this->visible = other.visible;
+        std::atomic_store(&this->cache, std::atomic_load(&other.cache));
+        return *this;
+    }
+
     Vector2 Curve::get_point(double s) const {
         throw std::logic_error("Curve.get_point(double s) is not implemented");
     }
 
+    Vector2 Curve::get_travel_point(double s) const {
+        return this->get_point(s);
+    }
+
     std::vector<Vector2> Curve::get_waypoints(int numPoints) const {
         std::vector<Vector2> output;
         this->get_waypoints(output, numPoints);
@@ -25,22 +39,84 @@ namespace path {
     }
 
     void Curve::get_waypoints(std::vector<Vector2>& output, int numPoints) const {
-        throw std::logic_error("Curve.get_waypoints(int numWaypoints) is not implemented");
+        WaypointBuffer buffer;
+        this->get_waypoints(buffer, numPoints);
+        buffer.append_positions(output);
     }
 
     void Curve::get_waypoints_spaced(std::vector<Vector2>& output, double ds) const {
-        throw std::logic_error("Curve.get_waypoints_spaced(double ds) is not implemented");
+        WaypointBuffer buffer;
+        this->get_waypoints_spaced(buffer, ds);
+        buffer.append_positions(output);
+    }
+
+    bool Curve::get_waypoints_into(WaypointBuffer& output, double ds) const noexcept {
+        // an owning buffer may allocate, which could throw
+        if (!output.is_fixed())
+            return false;
+        this->get_waypoints_spaced(output, ds);
+        return !output.truncated();
+    }
+
+    void Curve::get_waypoints(WaypointBuffer& output, int numPoints) const {
+        throw std::logic_error("Curve.get_waypoints(int numWaypoints) is not implemented");
+    }
+
+    double Curve::chord_step(double curvature, double tolerance, double dsMax) {
+        // a chord of length c on a circle of radius r has sagitta c^2 / 8r
+        curvature = std::fabs(curvature);
+        if (curvature * dsMax * dsMax <= 8 * tolerance)
+            return dsMax;
+        return std::sqrt(8 * tolerance / curvature);
     }
 
     double Curve::get_length() const {
         throw std::logic_error("Curve.get_length() is not implemented");
     }
 
+    BoundingBox Curve::get_bounding_box() const {
+        return this->get_bounding_box(0, this->get_length());
+    }
+
+    bool find_lookahead(const Curve* const* curves, std::size_t numCurves, Vector2 center, double radius,
+                        LookaheadCursor& cursor) {
+        for (auto i = cursor.curve; i < numCurves; ++i) {
+            double s;
+            if (curves[i]->intersect_circle(center, radius, i == cursor.curve ? cursor.s : 0, s)) {
+                cursor = {i, s};
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<const WaypointBuffer> Curve::get_cached_waypoints(double ds) const {
+        auto cached = std::atomic_load(&this->cache);
+        if (!cached || cached->ds != ds) {
+            // concurrent misses may both sample; either result is correct and the last one stays cached
+            auto fresh = std::make_shared<CachedWaypoints>();
+            fresh->ds = ds;
+            this->get_waypoints_spaced(fresh->waypoints, ds);
+            cached = std::move(fresh);
+            std::atomic_store(&this->cache, cached);
+        }
+        return {cached, &cached->waypoints};
+    }
+
+    void Curve::append_cached_waypoints(WaypointBuffer& output, double ds) const {
+        output.append(*this->get_cached_waypoints(ds), output.length());
+    }
+
+    void Curve::invalidate_cache() {
+        std::atomic_store(&this->cache, std::shared_ptr<const CachedWaypoints>());
+    }
+
     bool Curve::is_visible() const {
         return this->visible;
     }
 
     void Curve::set_visibility(bool visibility) {
         this->visible = visibility;
+        this->invalidate_cache();
     }
 }
\ No newline at end of file
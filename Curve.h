@@ -6,32 +6,193 @@
 #define VEX_PATH_PLANNER_CURVE_H
 
 #include <cmath>
+#include <memory>
 #include <vector>
 #include "Vector2.h"
+#include "BoundingBox.h"
 #include "MathUtils.h"
+#include "WaypointBuffer.h"
 
 namespace path {
+    /**
+     * @brief waypoints sampled at a given spacing, shared read-only between every reader of a cache
+     */
+    struct CachedWaypoints {
+        double ds;
+        WaypointBuffer waypoints;
+    };
+
+    /**
+     * @brief closest point on a curve to a query point
+     */
+    struct Projection {
+        double s;        // arc length along the direction of travel
+        Vector2 point;   // closest point
+        double distance; // distance from the query point to the closest point
+    };
+
+    /**
+     * @brief where a lookahead search along a sequence of curves left off
+     */
+    struct LookaheadCursor {
+        std::size_t curve = 0; // index of the curve the last lookahead point was on
+        double s = 0;          // arc length along that curve
+    };
 
     class Curve {
     public:
         explicit Curve(bool visible = true);
 
+        Curve(const Curve& other);
+        Curve& operator=(const Curve& other);
+        virtual ~Curve() = default;
+
         [[nodiscard]] virtual Vector2 get_point(double s) const;
+
+        /**
+         * @param s arc length along the direction of travel
+         * @return point at s. Same as get_point(s) unless the curve is parameterized against its direction of travel.
+         */
+        [[nodiscard]] virtual Vector2 get_travel_point(double s) const;
         [[nodiscard]] virtual double get_length() const;
 
-        virtual void get_waypoints(std::vector<Vector2>& output, int numPoints) const;
-        virtual void get_waypoints_spaced(std::vector<Vector2>& output, double ds) const;
+        /**
+         * @param s arc length along the direction of travel
+         * @return heading of the direction of travel at s
+         */
+        [[nodiscard]] virtual double get_heading(double s) const = 0;
+
+        /**
+         * @param s arc length along the direction of travel
+         * @return signed curvature at s, positive when turning left
+         */
+        [[nodiscard]] virtual double get_curvature(double s) const = 0;
+
+        /**
+         * @brief find the closest point on the curve
+         * @param p query point
+         * @return arc length, position and distance of the closest point
+         */
+        [[nodiscard]] virtual Projection project(Vector2 p) const = 0;
+
+        /**
+         * @brief find the first point, travelling from sMin, that lies on a circle
+         * @param center center of the circle
+         * @param radius radius of the circle
+         * @param sMin arc length to start searching from
+         * @param s set to the arc length of the intersection, if any
+         * @return whether the curve meets the circle at or after sMin
+         */
+        virtual bool intersect_circle(Vector2 center, double radius, double sMin, double& s) const = 0;
+
+        /**
+         * @brief smallest axis-aligned box containing part of the curve
+         * @param s0 arc length along the direction of travel where the part starts
+         * @param s1 arc length along the direction of travel where the part ends, at least s0
+         * @return bounding box of the part
+         */
+        [[nodiscard]] virtual BoundingBox get_bounding_box(double s0, double s1) const = 0;
+
+        /**
+         * @return smallest axis-aligned box containing the whole curve
+         */
+        [[nodiscard]] BoundingBox get_bounding_box() const;
+
+        /**
+         * @brief sample waypoints with position, heading, curvature and arc length
+         * @param output buffer to add waypoints to. Arc lengths continue from output.length().
+         * @param numPoints number of waypoints, including both ends
+         */
+        virtual void get_waypoints(WaypointBuffer& output, int numPoints) const;
+
+        /**
+         * @brief sample waypoints with position, heading, curvature and arc length
+         * @param output buffer to add waypoints to. Arc lengths continue from output.length().
+         * @param ds space between waypoints
+         */
+        virtual void get_waypoints_spaced(WaypointBuffer& output, double ds) const = 0;
+
+        /**
+         * @brief sample waypoints only as densely as the curvature requires: no chord between consecutive waypoints
+         * strays more than tolerance from the curve, and no two waypoints are more than dsMax apart.
+         * @param output buffer to add waypoints to. Arc lengths continue from output.length().
+         * @param tolerance maximum chord deviation (sagitta)
+         * @param dsMax maximum space between waypoints
+         */
+        virtual void get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const = 0;
+
+        /**
+         * @brief sample waypoints into a fixed-capacity buffer. Never allocates or throws; waypoints that do not fit are
+         * dropped and reported instead.
+         * @param output buffer over caller storage (output.is_fixed())
+         * @param ds space between waypoints
+         * @return whether every waypoint fit, i.e. !output.truncated(). False without sampling if output is not
+         * fixed.
+         */
+        bool get_waypoints_into(WaypointBuffer& output, double ds) const noexcept;
+
+        void get_waypoints(std::vector<Vector2>& output, int numPoints) const;
+        void get_waypoints_spaced(std::vector<Vector2>& output, double ds) const;
 
         [[nodiscard]] std::vector<Vector2> get_waypoints(int numPoints) const;
         [[nodiscard]] std::vector<Vector2> get_waypoints_spaced(double ds) const;
 
+        /**
+         * @brief waypoints spaced ds apart with arc lengths starting at 0, sampled once and reused until the curve is
+         * reconfigured or a different spacing is asked for. Safe to call from several threads at once, though not
+         * while the curve is being modified.
+         * @param ds space between waypoints
+         * @return read-only view of the cached waypoints, kept alive by the pointer even after the cache moves on
+         */
+        [[nodiscard]] std::shared_ptr<const WaypointBuffer> get_cached_waypoints(double ds) const;
+
+        /**
+         * @brief append the cached waypoints for spacing ds to output, continuing its arc length.
+         * Produces the same waypoints as get_waypoints_spaced(output, ds).
+         * @param output buffer to add waypoints to
+         * @param ds space between waypoints
+         */
+        void append_cached_waypoints(WaypointBuffer& output, double ds) const;
+
         [[nodiscard]] bool is_visible() const;
 
         void set_visibility(bool visibility);
 
+    protected:
+        /**
+         * @brief longest chord whose sagitta on a circle of the given curvature stays within tolerance,
+         * i.e. sqrt(8 tolerance / |curvature|), capped at dsMax
+         * @param curvature curvature of the osculating circle
+         * @param tolerance maximum chord deviation
+         * @param dsMax maximum step
+         * @return arc length step
+         */
+        static double chord_step(double curvature, double tolerance, double dsMax);
+
+        /**
+         * @brief drop the cached waypoints. Every mutator of a subclass that changes the geometry must call this.
+         */
+        void invalidate_cache();
+
     private:
         bool visible;
+
+        // replaced atomically, never modified in place, so readers can hold on to it without locking
+        mutable std::shared_ptr<const CachedWaypoints> cache;
     };
+
+    /**
+     * @brief pure pursuit lookahead: the first point on consecutive curves, at or after the cursor, that is radius away
+     * from center. The search resumes at the cursor, so while tracking steadily it only looks at the current curve.
+     * @param curves curves in order of travel
+     * @param numCurves number of curves
+     * @param center robot position
+     * @param radius lookahead distance
+     * @param cursor where the previous search stopped, advanced to the intersection if one is found
+     * @return whether an intersection was found
+     */
+    bool find_lookahead(const Curve* const* curves, std::size_t numCurves, Vector2 center, double radius,
+                        LookaheadCursor& cursor);
 } // path
 
 #endif //VEX_PATH_PLANNER_CURVE_H
@@ -0,0 +1,119 @@
+//
+// Created by Benjamin Lee on 8/31/24.
+//
+
+#include "CurveBVH.h"
+#include <algorithm>
+
+namespace path {
+    // curves per leaf
+    static constexpr std::uint32_t BVH_LEAF_SIZE = 2;
+
+    CurveBVH::CurveBVH(const std::vector<const Curve*>& curves) {
+        this->build(curves);
+    }
+
+    CurveBVH::CurveBVH(const Path& path) : CurveBVH(path.get_curves()) {}
+
+    void CurveBVH::build(const std::vector<const Curve*>& curves) {
+        this->boxes.clear();
+        this->items.clear();
+        this->nodes.clear();
+        if (curves.empty())
+            return;
+
+        this->boxes.reserve(curves.size());
+        for (auto curve: curves)
+            this->boxes.push_back(curve->get_bounding_box());
+
+        this->items.resize(curves.size());
+        for (std::uint32_t i = 0; i < curves.size(); ++i)
+            this->items[i] = i;
+
+        // a binary tree with leaves of up to BVH_LEAF_SIZE items has fewer than 2n nodes
+        this->nodes.reserve(2 * curves.size());
+        this->nodes.push_back({this->boxes[0], 0, 0});
+        this->build_node(0, 0, (std::uint32_t)curves.size());
+    }
+
+    void CurveBVH::build_node(std::size_t node, std::uint32_t first, std::uint32_t count) {
+        auto box = this->boxes[this->items[first]];
+        for (auto i = first + 1; i < first + count; ++i)
+            box.expand(this->boxes[this->items[i]]);
+        this->nodes[node].box = box;
+
+        if (count <= BVH_LEAF_SIZE) {
+            this->nodes[node].first = first;
+            this->nodes[node].count = count;
+            return;
+        }
+
+        // median split along the longer side of the box
+        auto size = box.get_size();
+        auto begin = this->items.begin() + first;
+        auto half = count / 2;
+        std::nth_element(begin, begin + half, begin + count, [&](std::uint32_t a, std::uint32_t b) {
+            auto ca = this->boxes[a].get_center();
+            auto cb = this->boxes[b].get_center();
+            return size.x >= size.y ? ca.x < cb.x : ca.y < cb.y;
+        });
+
+        auto left = (std::uint32_t)this->nodes.size();
+        this->nodes[node].first = left;
+        this->nodes[node].count = 0;
+        this->nodes.push_back({box, 0, 0});
+        this->nodes.push_back({box, 0, 0});
+        this->build_node(left, first, half);
+        this->build_node(left + 1, first + half, count - half);
+    }
+
+    template <typename F>
+    bool CurveBVH::traverse(const BoundingBox& box, F&& visit) const {
+        if (this->nodes.empty())
+            return false;
+
+        // depth is about log2(n), so a small fixed stack is plenty
+        std::uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const auto& node = this->nodes[stack[--top]];
+            if (!(node.box && box))
+                continue;
+
+            if (node.count > 0) {
+                for (auto i = node.first; i < node.first + node.count; ++i) {
+                    if ((this->boxes[this->items[i]] && box) && visit(this->items[i]))
+                        return true;
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = node.first + 1;
+            }
+        }
+        return false;
+    }
+
+    void CurveBVH::query(const BoundingBox& box, std::vector<std::size_t>& hits) const {
+        this->traverse(box, [&](std::uint32_t i) {
+            hits.push_back(i);
+            return false;
+        });
+    }
+
+    bool CurveBVH::intersects(const BoundingBox& box) const {
+        return this->traverse(box, [](std::uint32_t) { return true; });
+    }
+
+    const BoundingBox& CurveBVH::get_curve_box(std::size_t i) const {
+        return this->boxes[i];
+    }
+
+    BoundingBox CurveBVH::get_bounds() const {
+        return this->nodes.empty() ? BoundingBox(Vector2(0, 0)) : this->nodes[0].box;
+    }
+
+    std::size_t CurveBVH::size() const {
+        return this->boxes.size();
+    }
+} // path
@@ -0,0 +1,89 @@
+//
+// Created by Benjamin Lee on 8/31/24.
+//
+
+#ifndef VEX_PATH_PLANNER_CURVEBVH_H
+#define VEX_PATH_PLANNER_CURVEBVH_H
+
+#include <cstdint>
+#include <vector>
+#include "BoundingBox.h"
+#include "Curve.h"
+#include "Path.h"
+
+namespace path {
+    /**
+     * @brief bounding-volume hierarchy over the bounding boxes of a sequence of curves.
+     * Built top-down by splitting the curves at the median box center along the longer axis, so a query that overlaps
+     * k curves visits O(k log n) nodes instead of testing every curve or waypoint.
+     * Holds no pointers to the curves; rebuild it after they change.
+     */
+    class CurveBVH {
+    public:
+        CurveBVH() = default;
+
+        /**
+         * @param curves curves to index. Query results are indices into this list.
+         */
+        explicit CurveBVH(const std::vector<const Curve*>& curves);
+
+        /**
+         * @param path path whose curves to index. Query results are indices into path.get_curves().
+         */
+        explicit CurveBVH(const Path& path);
+
+        void build(const std::vector<const Curve*>& curves);
+
+        /**
+         * @brief find the curves whose bounding boxes overlap a box
+         * @param box query box
+         * @param hits indices of the overlapping curves are added here, in no particular order
+         */
+        void query(const BoundingBox& box, std::vector<std::size_t>& hits) const;
+
+        /**
+         * @param box query box
+         * @return whether any curve's bounding box overlaps box
+         */
+        [[nodiscard]] bool intersects(const BoundingBox& box) const;
+
+        /**
+         * @param i index of a curve
+         * @return bounding box of curve i
+         */
+        [[nodiscard]] const BoundingBox& get_curve_box(std::size_t i) const;
+
+        /**
+         * @return bounding box of every curve, or a box around the origin if there are none
+         */
+        [[nodiscard]] BoundingBox get_bounds() const;
+
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        struct Node {
+            BoundingBox box;
+            std::uint32_t first; // first item of a leaf, or the left child; the right child follows it
+            std::uint32_t count; // number of items of a leaf, 0 for an inner node
+        };
+
+        /**
+         * @brief build the subtree of node over items [first, first + count)
+         */
+        void build_node(std::size_t node, std::uint32_t first, std::uint32_t count);
+
+        /**
+         * @brief visit every leaf item whose box overlaps box until visit returns true
+         * @return whether visit returned true
+         */
+        template <typename F>
+        bool traverse(const BoundingBox& box, F&& visit) const;
+
+        std::vector<BoundingBox> boxes; // per curve
+        std::vector<std::uint32_t> items; // curve indices, grouped by leaf
+        std::vector<Node> nodes;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_CURVEBVH_H
@@ -0,0 +1,230 @@
+//
+// Created by Benjamin Lee on 9/4/24.
+//
+
+#ifndef VEX_PATH_PLANNER_FIXED_H
+#define VEX_PATH_PLANNER_FIXED_H
+
+#include <cstdint>
+
+namespace path {
+    /**
+     * @brief Q16.16 signed fixed-point number for targets without a fast FPU.
+     * Range is [-32768, 32768) with a resolution of 2^-16 (about 1.5e-5). Products and quotients are computed in 64
+     * bits and rounded; results outside the range wrap. sqrt, hypot, sin, cos, atan2 and acos use integer arithmetic
+     * only and are accurate to a few units in the last place. They are hidden friends, found by argument-dependent
+     * lookup, so they never shadow the standard functions for double.
+     */
+    class Fixed {
+    public:
+        static constexpr int FRACTION_BITS = 16;
+        static constexpr std::int32_t ONE = 1 << FRACTION_BITS;
+
+        Fixed() = default;
+
+        constexpr Fixed(int value) : raw(value * ONE) {}
+
+        constexpr Fixed(double value) : raw((std::int32_t)(value * ONE + (value < 0 ? -0.5 : 0.5))) {}
+
+        /**
+         * @param raw value times 2^16
+         * @return fixed-point number with the given representation
+         */
+        static constexpr Fixed from_raw(std::int32_t raw) {
+            Fixed res;
+            res.raw = raw;
+            return res;
+        }
+
+        [[nodiscard]] constexpr std::int32_t get_raw() const {
+            return this->raw;
+        }
+
+        constexpr explicit operator double() const {
+            return (double)this->raw / ONE;
+        }
+
+        constexpr explicit operator float() const {
+            return (float)this->raw / ONE;
+        }
+
+        /**
+         * @return value rounded toward zero
+         */
+        constexpr explicit operator int() const {
+            return this->raw / ONE;
+        }
+
+        constexpr Fixed operator-() const {
+            return from_raw(-this->raw);
+        }
+
+        constexpr Fixed operator+() const {
+            return *this;
+        }
+
+        friend constexpr Fixed operator+(Fixed a, Fixed b) {
+            return from_raw(a.raw + b.raw);
+        }
+
+        friend constexpr Fixed operator-(Fixed a, Fixed b) {
+            return from_raw(a.raw - b.raw);
+        }
+
+        friend constexpr Fixed operator*(Fixed a, Fixed b) {
+            return from_raw((std::int32_t)(((std::int64_t)a.raw * b.raw + (ONE >> 1)) >> FRACTION_BITS));
+        }
+
+        friend constexpr Fixed operator/(Fixed a, Fixed b) {
+            // round half away from zero
+            auto n = (std::int64_t)a.raw * ONE;
+            auto half = (b.raw < 0 ? -(std::int64_t)b.raw : b.raw) / 2;
+            return from_raw((std::int32_t)((n + (n < 0 ? -half : half)) / b.raw));
+        }
+
+        constexpr Fixed& operator+=(Fixed other) {
+            return *this = *this + other;
+        }
+
+        constexpr Fixed& operator-=(Fixed other) {
+            return *this = *this - other;
+        }
+
+        constexpr Fixed& operator*=(Fixed other) {
+            return *this = *this * other;
+        }
+
+        constexpr Fixed& operator/=(Fixed other) {
+            return *this = *this / other;
+        }
+
+        friend constexpr bool operator==(Fixed a, Fixed b) {
+            return a.raw == b.raw;
+        }
+
+        friend constexpr bool operator!=(Fixed a, Fixed b) {
+            return a.raw != b.raw;
+        }
+
+        friend constexpr bool operator<(Fixed a, Fixed b) {
+            return a.raw < b.raw;
+        }
+
+        friend constexpr bool operator>(Fixed a, Fixed b) {
+            return a.raw > b.raw;
+        }
+
+        friend constexpr bool operator<=(Fixed a, Fixed b) {
+            return a.raw <= b.raw;
+        }
+
+        friend constexpr bool operator>=(Fixed a, Fixed b) {
+            return a.raw >= b.raw;
+        }
+
+        friend constexpr Fixed fabs(Fixed x) {
+            return x.raw < 0 ? -x : x;
+        }
+
+        friend constexpr Fixed floor(Fixed x) {
+            return from_raw(x.raw & ~(ONE - 1));
+        }
+
+        friend constexpr Fixed sqrt(Fixed x) {
+            return x.raw <= 0 ? Fixed(0) : from_raw((std::int32_t)isqrt((std::uint64_t)x.raw << FRACTION_BITS));
+        }
+
+        /**
+         * @brief sqrt(x^2 + y^2) without the overflow of squaring in Q16.16, which would wrap past 181
+         */
+        friend constexpr Fixed hypot(Fixed x, Fixed y) {
+            auto x2 = (std::int64_t)x.raw * x.raw;
+            auto y2 = (std::int64_t)y.raw * y.raw;
+            return from_raw((std::int32_t)isqrt((std::uint64_t)(x2 + y2)));
+        }
+
+        friend constexpr Fixed sin(Fixed x) {
+            // reduce to [-pi, pi], then to [-pi/2, pi/2] by sin(x) = sin(pi - x)
+            auto r = x.raw % TWO_PI;
+            if (r > PI)
+                r -= TWO_PI;
+            else if (r < -PI)
+                r += TWO_PI;
+            if (r > PI / 2)
+                r = PI - r;
+            else if (r < -PI / 2)
+                r = -PI - r;
+
+            // Taylor series to x^9, whose remainder is below the resolution on [-pi/2, pi/2]
+            auto t = from_raw(r);
+            auto t2 = t * t;
+            auto sum = Fixed(1) - t2 / 72;
+            sum = Fixed(1) - t2 / 42 * sum;
+            sum = Fixed(1) - t2 / 20 * sum;
+            sum = Fixed(1) - t2 / 6 * sum;
+            return t * sum;
+        }
+
+        friend constexpr Fixed cos(Fixed x) {
+            return sin(from_raw(x.raw % TWO_PI + PI / 2));
+        }
+
+        friend constexpr Fixed atan2(Fixed y, Fixed x) {
+            if (x.raw == 0 && y.raw == 0)
+                return 0;
+
+            // atan of the ratio of the smaller to the larger component, in [0, pi/4]
+            auto ax = fabs(x);
+            auto ay = fabs(y);
+            bool steep = ay > ax;
+            auto z = steep ? ax / ay : ay / ax;
+            auto z2 = z * z;
+
+            // minimax polynomial for atan on [0, 1], absolute error below 1e-5
+            auto poly = Fixed(0.0208351) * z2 - Fixed(0.0851330);
+            poly = poly * z2 + Fixed(0.1801410);
+            poly = poly * z2 - Fixed(0.3302995);
+            poly = poly * z2 + Fixed(0.9998660);
+            auto angle = poly * z;
+
+            if (steep)
+                angle = from_raw(PI / 2) - angle;
+            if (x.raw < 0)
+                angle = from_raw(PI) - angle;
+            return y.raw < 0 ? -angle : angle;
+        }
+
+        friend constexpr Fixed acos(Fixed x) {
+            return atan2(sqrt(Fixed(1) - x * x), x);
+        }
+
+    private:
+        static constexpr std::int32_t PI = 205887;     // pi * 2^16
+        static constexpr std::int32_t TWO_PI = 411775; // 2 pi * 2^16
+
+        /**
+         * @return floor(sqrt(n)), digit by digit
+         */
+        static constexpr std::uint64_t isqrt(std::uint64_t n) {
+            std::uint64_t res = 0;
+            std::uint64_t bit = (std::uint64_t)1 << 62;
+            while (bit > n)
+                bit >>= 2;
+            while (bit) {
+                if (n >= res + bit) {
+                    n -= res + bit;
+                    res = (res >> 1) + bit;
+                } else {
+                    res >>= 1;
+                }
+                bit >>= 2;
+            }
+            return res;
+        }
+
+        std::int32_t raw = 0;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_FIXED_H
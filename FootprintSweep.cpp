@@ -0,0 +1,149 @@
+//
+// Created by Benjamin Lee on 9/2/24.
+//
+
+#include "FootprintSweep.h"
+#include <algorithm>
+#include <cmath>
+
+namespace path {
+    // halvings past tolerance spent telling near misses from collisions
+    static constexpr int SWEEP_NEAR_MISS_DEPTH = 6;
+
+    FootprintSweep::FootprintSweep(const std::vector<BoundingBox>& obstacles, Footprint footprint, double tolerance) :
+            obstacles(obstacles), footprint(footprint), tolerance(tolerance) {
+        this->offset = {(footprint.front - footprint.back) / 2, (footprint.left - footprint.right) / 2};
+        this->halfLength = (footprint.front + footprint.back) / 2;
+        this->halfWidth = (footprint.left + footprint.right) / 2;
+        this->radius = std::hypot(std::max(footprint.front, footprint.back), std::max(footprint.left, footprint.right));
+    }
+
+    bool FootprintSweep::overlaps(Vector2 position, double heading, double margin, std::uint32_t obstacle) const {
+        auto box = this->obstacles.get(obstacle);
+        Vector2 u{std::cos(heading), std::sin(heading)};
+        Vector2 v{-u.y, u.x};
+        auto a = this->halfLength + margin;
+        auto b = this->halfWidth + margin;
+        auto e = box.get_size() / 2;
+        auto d = position + u * this->offset.x + v * this->offset.y - box.get_center();
+
+        // the two boxes are disjoint iff their projections are disjoint on one of x, y, u or v
+        return std::fabs(d.x) <= e.x + a * std::fabs(u.x) + b * std::fabs(v.x) &&
+               std::fabs(d.y) <= e.y + a * std::fabs(u.y) + b * std::fabs(v.y) &&
+               std::fabs(d.dot(u)) <= a + e.x * std::fabs(u.x) + e.y * std::fabs(u.y) &&
+               std::fabs(d.dot(v)) <= b + e.x * std::fabs(v.x) + e.y * std::fabs(v.y);
+    }
+
+    bool FootprintSweep::collides(Vector2 position, double heading) const {
+        for (std::uint32_t i = 0; i < this->obstacles.size(); ++i) {
+            if (this->overlaps(position, heading, 0, i))
+                return true;
+        }
+        return false;
+    }
+
+    bool FootprintSweep::refine(const Curve& curve, double s0, double s1, std::vector<std::uint32_t>& candidates,
+                                std::size_t first, double& s) const {
+        auto box = curve.get_bounding_box(s0, s1);
+        Vector2 inflate{this->radius, this->radius};
+        box = {box.get_corner_min() - inflate, box.get_corner_max() + inflate};
+
+        // curvature is linear in s on every curve, so |kappa| peaks at an end. Within h/2 of the middle the tracking
+        // point moves at most h/2 and the heading turns at most kMax h/2, moving each corner at most R kMax h/2.
+        auto h = s1 - s0;
+        auto kMax = std::max(std::fabs(curve.get_curvature(s0)), std::fabs(curve.get_curvature(s1)));
+        auto margin = h / 2 * (1 + this->radius * kMax);
+        auto mid = (s0 + s1) / 2;
+        auto position = curve.get_travel_point(mid);
+        auto heading = curve.get_heading(mid);
+
+        auto end = candidates.size();
+        for (auto i = first; i < end; ++i) {
+            auto obstacle = candidates[i];
+            if (this->obstacles.get(obstacle) && box && this->overlaps(position, heading, margin, obstacle))
+                candidates.push_back(obstacle);
+        }
+
+        bool hit = false;
+        if (candidates.size() > end) {
+            // a short part is a collision once the footprint at its middle really overlaps, or once it is so short
+            // that the grown footprint is a near miss by a negligible margin
+            bool touching = false;
+            if (h <= this->tolerance) {
+                for (auto i = end; i < candidates.size() && !touching; ++i)
+                    touching = this->overlaps(position, heading, 0, candidates[i]);
+            }
+            if (touching || h <= std::ldexp(this->tolerance, -SWEEP_NEAR_MISS_DEPTH)) {
+                s = s0;
+                hit = true;
+            } else {
+                hit = this->refine(curve, s0, mid, candidates, end, s) ||
+                      this->refine(curve, mid, s1, candidates, end, s);
+            }
+        }
+        candidates.resize(end);
+        return hit;
+    }
+
+    bool FootprintSweep::sweep(const Curve& curve, std::vector<std::uint32_t>& candidates,
+                               std::vector<std::uint64_t>& mask, double& s) const {
+        auto length = curve.get_length();
+        if (length <= 0 || this->obstacles.empty())
+            return false;
+
+        // cull the obstacles a whole batch at a time against the curve's inflated box
+        auto box = curve.get_bounding_box();
+        Vector2 inflate{this->radius, this->radius};
+        this->obstacles.overlaps({box.get_corner_min() - inflate, box.get_corner_max() + inflate}, mask.data());
+
+        candidates.clear();
+        for (std::uint32_t i = 0; i < this->obstacles.size(); ++i) {
+            if ((mask[i / 64] >> (i % 64)) & 1)
+                candidates.push_back(i);
+        }
+        if (candidates.empty())
+            return false;
+        return this->refine(curve, 0, length, candidates, 0, s);
+    }
+
+    bool FootprintSweep::sweep(const Curve& curve, double& s) const {
+        std::vector<std::uint32_t> candidates;
+        std::vector<std::uint64_t> mask(this->obstacles.mask_words());
+        return this->sweep(curve, candidates, mask, s);
+    }
+
+    bool FootprintSweep::sweep(const std::vector<const Curve*>& curves, double& s) const {
+        std::vector<std::uint32_t> candidates;
+        std::vector<std::uint64_t> mask(this->obstacles.mask_words());
+        double start = 0;
+        for (auto curve: curves) {
+            if (this->sweep(*curve, candidates, mask, s)) {
+                s += start;
+                return true;
+            }
+            start += curve->get_length();
+        }
+        return false;
+    }
+
+    bool FootprintSweep::sweep(const Joint& joint, double& s) const {
+        std::vector<const Curve*> curves{&joint.get_line1(), &joint.get_clothoid1()};
+        if (joint.get_arc().is_visible())
+            curves.push_back(&joint.get_arc());
+        curves.push_back(&joint.get_clothoid2());
+        curves.push_back(&joint.get_line2());
+        return this->sweep(curves, s);
+    }
+
+    bool FootprintSweep::sweep(const Path& path, double& s) const {
+        return this->sweep(path.get_curves(), s);
+    }
+
+    const Footprint& FootprintSweep::get_footprint() const {
+        return this->footprint;
+    }
+
+    const BoundingBoxSet& FootprintSweep::get_obstacles() const {
+        return this->obstacles;
+    }
+} // path
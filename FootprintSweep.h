@@ -0,0 +1,117 @@
+//
+// Created by Benjamin Lee on 9/2/24.
+//
+
+#ifndef VEX_PATH_PLANNER_FOOTPRINTSWEEP_H
+#define VEX_PATH_PLANNER_FOOTPRINTSWEEP_H
+
+#include <cstdint>
+#include <vector>
+#include "BoundingBox.h"
+#include "BoundingBoxSet.h"
+#include "Curve.h"
+#include "Joint.h"
+#include "Path.h"
+
+namespace path {
+    /**
+     * @brief rectangular robot footprint, as distances from the tracking point to each side.
+     * Forward is the direction of travel, left is 90 degrees CCW of it.
+     */
+    struct Footprint {
+        double front;
+        double back;
+        double left;
+        double right;
+    };
+
+    /**
+     * @brief checks the footprint of a robot, swept along curves with their analytic heading, against axis-aligned
+     * obstacles.
+     * Each curve is first culled by its bounding box inflated by the footprint's circumradius, then split in halves,
+     * travelling forward, only while some obstacle still overlaps the part being refined. A part of length h is tested
+     * as the footprint at its middle grown by h/2 (1 + R kMax) on every side, which contains the footprint everywhere
+     * on the part, against each remaining obstacle with the separating axis test. A part no longer than tolerance is a
+     * collision once the footprint at its middle overlaps an obstacle; otherwise it is halved a few more times to rule
+     * out a near miss.
+     * The check is conservative: every collision is found, and the reported arc length is at most tolerance before
+     * the first one. A near miss by less than about tolerance (1 + R kMax) / 128 may be reported as a collision.
+     */
+    class FootprintSweep {
+    public:
+        /**
+         * @param obstacles field obstacles
+         * @param footprint robot footprint
+         * @param tolerance how far before the first collision the reported arc length may be
+         */
+        FootprintSweep(const std::vector<BoundingBox>& obstacles, Footprint footprint, double tolerance = 0.1);
+
+        /**
+         * @param position tracking point of the robot
+         * @param heading heading of the robot
+         * @return whether the footprint at this pose overlaps any obstacle
+         */
+        [[nodiscard]] bool collides(Vector2 position, double heading) const;
+
+        /**
+         * @param curve curve to sweep along, in its direction of travel
+         * @param s set to the arc length of the first collision, if any
+         * @return whether the swept footprint overlaps any obstacle
+         */
+        bool sweep(const Curve& curve, double& s) const;
+
+        /**
+         * @param curves curves to sweep along, in order of travel
+         * @param s set to the arc length of the first collision from the start of the first curve, if any
+         * @return whether the swept footprint overlaps any obstacle
+         */
+        bool sweep(const std::vector<const Curve*>& curves, double& s) const;
+
+        /**
+         * @param joint joint to sweep along: line, clothoid, arc (if visible), clothoid, line
+         * @param s set to the arc length of the first collision from the start of the joint, if any
+         * @return whether the swept footprint overlaps any obstacle
+         */
+        bool sweep(const Joint& joint, double& s) const;
+
+        /**
+         * @param path path to sweep along
+         * @param s set to the arc length of the first collision from the start of the path, if any
+         * @return whether the swept footprint overlaps any obstacle
+         */
+        bool sweep(const Path& path, double& s) const;
+
+        [[nodiscard]] const Footprint& get_footprint() const;
+        [[nodiscard]] const BoundingBoxSet& get_obstacles() const;
+
+    private:
+        /**
+         * @brief separating axis test of the footprint at a pose, grown by margin on every side, against one obstacle
+         */
+        [[nodiscard]] bool overlaps(Vector2 position, double heading, double margin, std::uint32_t obstacle) const;
+
+        /**
+         * @brief refine part [s0, s1] of a curve against obstacles candidates[first, end())
+         * @param candidates scratch stack of obstacle indices; survivors of this part are pushed above first and
+         * popped again before returning
+         * @return whether a collision was found, with s set to its arc length along the curve
+         */
+        bool refine(const Curve& curve, double s0, double s1, std::vector<std::uint32_t>& candidates,
+                    std::size_t first, double& s) const;
+
+        bool sweep(const Curve& curve, std::vector<std::uint32_t>& candidates, std::vector<std::uint64_t>& mask,
+                   double& s) const;
+
+        BoundingBoxSet obstacles;
+        Footprint footprint;
+        double tolerance;
+
+        Vector2 offset;    // center of the footprint from the tracking point, in the robot frame
+        double halfLength; // along the heading
+        double halfWidth;  // across the heading
+        double radius;     // farthest corner from the tracking point
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_FOOTPRINTSWEEP_H
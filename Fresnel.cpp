@@ -4,53 +4,177 @@
 
 #include "Fresnel.h"
 #include "MathUtils.h"
+#include <complex>
 
 namespace path {
-    Vector2 FRESNEL_TABLE[FRESNEL_TABLE_SIZE];
+    constexpr FresnelTable<FRESNEL_TABLE_SIZE, FRESNEL_TABLE_ORDER> FRESNEL_TABLE;
+    constexpr FresnelTable<FRESNEL_NARROW_TABLE_SIZE, FRESNEL_TABLE_ORDER, float, FRESNEL_NARROW_TABLE_MAX>
+            FRESNEL_TABLE_FLOAT;
+    constexpr FresnelTable<FRESNEL_NARROW_TABLE_SIZE, FRESNEL_TABLE_ORDER, Fixed, FRESNEL_NARROW_TABLE_MAX>
+            FRESNEL_TABLE_FIXED;
 
-    void init_fresnel() {
-        auto tmp = moving_integral<double, Vector2>([](double x) -> Vector2 {
-            return {cos(M_PI_2 * x * x),  sin(M_PI_2 * x * x)};
-        }, 0, 1, FRESNEL_TABLE_SIZE);
+    void init_fresnel() {}
 
-        std::copy(tmp.begin(), tmp.end(), FRESNEL_TABLE);
+    /**
+     * @brief continued fraction of the complementary error function, evaluated with the modified Lentz method.
+     * C(s) + iS(s) = (1 + i)/2 * (1 - e^(i pi s^2 / 2) (1 - i) s h) with
+     * h = 1 / (1 - i pi s^2 - 1*2 / (5 - i pi s^2 - 3*4 / (9 - i pi s^2 - ...))).
+     * Every truncation is a rational function of s, and few terms are needed once s is past the series range.
+     * @param s argument, FRESNEL_SERIES_MAX < s < FRESNEL_ASYMPTOTIC_MIN
+     * @return (C(s), S(s))
+     */
+    static Vector2 fresnel_continued_fraction(double s) {
+        auto pix2 = M_PI * s * s;
+        std::complex<double> b(1, -pix2);
+        std::complex<double> c = 1e300;
+        std::complex<double> d = 1.0 / b;
+        std::complex<double> h = d;
+
+        for (int n = 1; n < 200; n += 2) {
+            double a = -n * (n + 1);
+            b += 4.0;
+            d = 1.0 / (a * d + b);
+            c = b + a / c;
+            auto delta = c * d;
+            h *= delta;
+            if (std::abs(delta - 1.0) < 1e-16)
+                break;
+        }
+        h *= std::complex<double>(s, -s);
+
+        auto res = std::complex<double>(0.5, 0.5) * (1.0 - std::polar(1.0, pix2 / 2) * h);
+        return {res.real(), res.imag()};
     }
 
-    double fresnel_C(double s) {
-        assert(s <= 1);
+    /**
+     * @brief asymptotic expansion through the auxiliary functions f and g:
+     * C(s) = 1/2 + f sin(pi s^2 / 2) - g cos(pi s^2 / 2), S(s) = 1/2 - f cos(pi s^2 / 2) - g sin(pi s^2 / 2).
+     * @param s argument, s >= FRESNEL_ASYMPTOTIC_MIN
+     * @return (C(s), S(s))
+     */
+    static Vector2 fresnel_asymptotic(double s) {
+        auto x = 1 / (M_PI * s * s);
+        auto x2 = x * x;
 
-        if (s == 1)
-            return FRESNEL_TABLE[FRESNEL_TABLE_SIZE - 1].x;
+        // f ~ 1/(pi s) sum (-1)^m (4m-1)!! x^2m, g ~ 1/(pi s) sum (-1)^m (4m+1)!! x^(2m+1)
+        double f = 0;
+        double g = 0;
+        double fTerm = 1;
+        double gTerm = x;
+        for (int m = 0; m < 32; ++m) {
+            f += fTerm;
+            g += gTerm;
+            auto nextF = -fTerm * (4 * m + 1) * (4 * m + 3) * x2;
+            auto nextG = -gTerm * (4 * m + 3) * (4 * m + 5) * x2;
 
-        auto t = s * FRESNEL_TABLE_SIZE;
-        auto idx = (int)t;
+            // the series diverges, so stop at its smallest term
+            if (std::fabs(nextF) >= std::fabs(fTerm) || std::fabs(nextF) < 1e-17)
+                break;
+            fTerm = nextF;
+            gTerm = nextG;
+        }
+        f /= M_PI * s;
+        g /= M_PI * s;
 
-        t -= idx;
-        return lerp<double, double>(FRESNEL_TABLE[idx].x, FRESNEL_TABLE[idx + 1].x, t);
+        auto theta = M_PI_2 * s * s;
+        auto c = std::cos(theta);
+        auto sn = std::sin(theta);
+        return {0.5 + f * sn - g * c, 0.5 - f * c - g * sn};
     }
 
-    double fresnel_S(double s) {
-        assert(s <= 1);
+    Vector2 fresnel_vec(double s) {
+        auto u = std::fabs(s);
+        Vector2 res;
+        if (u <= 1)
+            res = FRESNEL_TABLE.interpolate(u);
+        else if (u <= FRESNEL_SERIES_MAX)
+            res = fresnel_series(u);
+        else if (u < FRESNEL_ASYMPTOTIC_MIN)
+            res = fresnel_continued_fraction(u);
+        else
+            res = fresnel_asymptotic(u);
 
-        if (s == 1)
-            return FRESNEL_TABLE[FRESNEL_TABLE_SIZE - 1].y;
+        // C and S are odd
+        return s < 0 ? -res : res;
+    }
+
+    /**
+     * @brief fresnel_asymptotic in a narrower scalar type. The phase pi s^2 / 2 is reduced modulo 2 pi by expanding
+     * s = n + r, so s^2 never has to be formed: it would lose every fractional bit in float and overflow Fixed.
+     * @param s argument, s >= FRESNEL_NARROW_TABLE_MAX
+     * @return (C(s), S(s))
+     */
+    template <typename T>
+    static BasicVector2<T> fresnel_asymptotic_narrow(T s) {
+        using std::fabs, std::floor, std::cos, std::sin;
+        auto inv = 1 / (T(M_PI) * s);
+        auto x = inv / s;
+        auto x2 = x * x;
 
-        auto t = s * FRESNEL_TABLE_SIZE;
-        auto idx = (int)t;
+        T f = 0;
+        T g = 0;
+        T fTerm = 1;
+        T gTerm = x;
+        for (int m = 0; m < 32; ++m) {
+            f += fTerm;
+            g += gTerm;
+            auto nextF = -fTerm * T((4 * m + 1) * (4 * m + 3)) * x2;
+            auto nextG = -gTerm * T((4 * m + 3) * (4 * m + 5)) * x2;
+            if (fabs(nextF) >= fabs(fTerm) || nextF == 0)
+                break;
+            fTerm = nextF;
+            gTerm = nextG;
+        }
+        f *= inv;
+        g *= inv;
 
-        t -= idx;
-        return lerp<double, double>(FRESNEL_TABLE[idx].y, FRESNEL_TABLE[idx + 1].y, t);
+        // s^2 mod 4 = (n^2 mod 4) + 2 n r + r^2, and n^2 mod 4 is 1 for odd n and 0 otherwise
+        auto n = (int)s;
+        auto r = s - T(n);
+        auto q = T(n % 2) + 2 * T(n) * r + r * r;
+        q -= 4 * floor(q / 4);
+        auto theta = T(M_PI_2) * q;
+        auto c = cos(theta);
+        auto sn = sin(theta);
+        return {T(0.5) + f * sn - g * c, T(0.5) - f * c - g * sn};
     }
 
-    Vector2 fresnel_vec(double s) {
-        assert(s <= 1);
+    /**
+     * @brief fresnel_vec for a narrower scalar type, using that type's table and asymptotic expansion
+     */
+    template <typename T, typename Table>
+    static BasicVector2<T> fresnel_narrow(T s, const Table& table) {
+        auto u = s < 0 ? -s : s;
+        auto res = u <= T(FRESNEL_NARROW_TABLE_MAX) ? table.interpolate(u) : fresnel_asymptotic_narrow(u);
+        return s < 0 ? -res : res;
+    }
 
-        if (s == 1)
-            return FRESNEL_TABLE[FRESNEL_TABLE_SIZE - 1];
+    BasicVector2<float> fresnel_vec(float s) {
+        return fresnel_narrow(s, FRESNEL_TABLE_FLOAT);
+    }
+
+    BasicVector2<Fixed> fresnel_vec(Fixed s) {
+        return fresnel_narrow(s, FRESNEL_TABLE_FIXED);
+    }
+
+    double fresnel_C(double s) {
+        return fresnel_vec(s).x;
+    }
+
+    double fresnel_S(double s) {
+        return fresnel_vec(s).y;
+    }
 
-        auto t = s * FRESNEL_TABLE_SIZE;
-        auto idx = (int)t;
-        t -= idx;
-        return lerp<double, Vector2>(FRESNEL_TABLE[idx], FRESNEL_TABLE[idx + 1], t);
+    FresnelAccuracy fresnel_table_accuracy(int samples) {
+        FresnelAccuracy res = {FRESNEL_TABLE_SIZE, FRESNEL_TABLE_ORDER, (int)sizeof(FRESNEL_TABLE), 0, 0};
+        for (int i = 0; i <= samples; ++i) {
+            auto s = (double)i / samples;
+            auto err = (FRESNEL_TABLE.interpolate(s) - fresnel_series(s)).norm();
+            if (err > res.maxError) {
+                res.maxError = err;
+                res.worstArg = s;
+            }
+        }
+        return res;
     }
 }
\ No newline at end of file
@@ -10,13 +10,189 @@
 
 #pragma once
 
-#define FRESNEL_TABLE_SIZE 5000
+/*
+ * Table resolution and interpolation order (1, 3 or 5); see FresnelTable and fresnel_table_accuracy().
+ * Measured worst absolute error on [0, 1]:
+ *   size  order  bytes   error
+ *   5000    1    80016   1.6e-8
+ *     64    3     2048   7.0e-9
+ *    128    3     4096   4.3e-10
+ *    256    3     8192   2.6e-11
+ *     32    5     1024   2.3e-11
+ *     64    5     2048   3.4e-13
+ */
+#ifndef FRESNEL_TABLE_SIZE
+#define FRESNEL_TABLE_SIZE 128
+#endif
+#ifndef FRESNEL_TABLE_ORDER
+#define FRESNEL_TABLE_ORDER 3
+#endif
+
+// largest argument evaluated with the power series before cancellation sets in
+#define FRESNEL_SERIES_MAX 2.0
+// arguments at or above this use the asymptotic expansion instead of the continued fraction
+#define FRESNEL_ASYMPTOTIC_MIN 6.0
+
+// the float and Fixed tables cover [0, FRESNEL_NARROW_TABLE_MAX] at the spacing of FRESNEL_TABLE, and the asymptotic
+// expansion in the same type takes over beyond it, where its smallest term is below float resolution
+#define FRESNEL_NARROW_TABLE_MAX 3
+#define FRESNEL_NARROW_TABLE_SIZE ((FRESNEL_TABLE_SIZE - 1) * FRESNEL_NARROW_TABLE_MAX + 1)
 
 namespace path {
-    extern Vector2 FRESNEL_TABLE[FRESNEL_TABLE_SIZE];
+    /**
+     * @brief power series C(s) = sum (-1)^n (pi/2)^2n s^(4n+1) / ((2n)! (4n+1)), and likewise for S(s).
+     * Usable in constant expressions.
+     * @param s argument, 0 <= s <= FRESNEL_SERIES_MAX
+     * @return (C(s), S(s))
+     */
+    constexpr Vector2 fresnel_series(double s) {
+        auto z = M_PI_2 * s * s;
+        auto z2 = z * z;
+
+        // term = (-1)^n z^2n s / (2n)!, so C gets term / (4n+1) and S gets term * z / ((2n+1)(4n+3))
+        auto term = s;
+        Vector2 sum = {0, 0};
+        for (int n = 0; n < 64; ++n) {
+            auto c = term / (4 * n + 1);
+            auto d = term * z / ((2 * n + 1) * (4 * n + 3));
+            sum.x += c;
+            sum.y += d;
+
+            auto magnitude = (c < 0 ? -c : c) + (d < 0 ? -d : d);
+            auto total = (sum.x < 0 ? -sum.x : sum.x) + (sum.y < 0 ? -sum.y : sum.y);
+            if (magnitude < 1e-17 * total)
+                break;
+            term *= -z2 / ((2 * n + 1) * (2 * n + 2));
+        }
+        return sum;
+    }
+
+    /**
+     * @brief (C(s), S(s)) sampled at N evenly spaced points on [0, Max], generated at compile time.
+     * Order 1 interpolates linearly. Orders 3 and 5 use cubic and quintic Hermite interpolation with the analytic
+     * derivatives F'(s) = (cos(pi s^2 / 2), sin(pi s^2 / 2)) and F''(s) = pi s (-F'_y(s), F'_x(s)), which reach the
+     * accuracy of the linear table with far fewer entries. Only the first derivative is stored.
+     * Entries are generated in double and rounded to T, and interpolation runs entirely in T.
+     * @tparam N number of entries
+     * @tparam Order interpolation order: 1, 3 or 5
+     * @tparam T scalar type of the entries: double, float or Fixed
+     * @tparam Max largest argument covered
+     */
+    template <int N, int Order = 3, typename T = double, int Max = 1>
+    struct FresnelTable {
+        static_assert(N >= 2, "a fresnel table needs at least two entries");
+        static_assert(Order == 1 || Order == 3 || Order == 5, "fresnel table interpolation order must be 1, 3 or 5");
+        static constexpr int size = N;
+        static constexpr int order = Order;
+
+        BasicVector2<T> values[N] {};
+        BasicVector2<T> slopes[Order > 1 ? N : 1] {};
+
+        constexpr FresnelTable() {
+            for (int i = 0; i < N; ++i) {
+                auto s = (double)i * Max / (N - 1);
+                values[i] = BasicVector2<T>(fresnel_series(s));
+                if (Order > 1) {
+                    // the series have no range reduction, so bring the phase into [-pi, pi] first
+                    auto phase = M_PI_2 * s * s;
+                    phase -= 2 * M_PI * (long long)(phase / (2 * M_PI) + 0.5);
+                    slopes[i] = {T(cos_series(phase)), T(sin_series(phase))};
+                }
+            }
+        }
+
+        constexpr const BasicVector2<T>& operator[](int i) const {
+            return values[i];
+        }
+
+        /**
+         * @brief interpolate the table
+         * @param s argument, 0 <= s <= Max
+         * @return (C(s), S(s))
+         */
+        BasicVector2<T> interpolate(T s) const {
+            if (s >= Max)
+                return values[N - 1];
+
+            auto t = s * T((double)(N - 1) / Max);
+            auto idx = (int)t;
+            if (idx > N - 2)
+                idx = N - 2;
+            t -= idx;
+
+            if (Order == 1)
+                return lerp<T, BasicVector2<T>>(values[idx], values[idx + 1], t);
+
+            constexpr T h = (double)Max / (N - 1);
+            auto t2 = t * t;
+            auto t3 = t2 * t;
+            if (Order == 3) {
+                return values[idx] * (2 * t3 - 3 * t2 + 1) + slopes[idx] * (h * (t3 - 2 * t2 + t)) +
+                       values[idx + 1] * (3 * t2 - 2 * t3) + slopes[idx + 1] * (h * (t3 - t2));
+            }
+
+            auto t4 = t3 * t;
+            auto t5 = t4 * t;
+            auto x0 = idx * h;
+            auto x1 = x0 + h;
+            auto curve0 = BasicVector2<T>(-slopes[idx].y, slopes[idx].x) * (T(M_PI) * x0);
+            auto curve1 = BasicVector2<T>(-slopes[idx + 1].y, slopes[idx + 1].x) * (T(M_PI) * x1);
+            return values[idx] * (1 - 10 * t3 + 15 * t4 - 6 * t5) +
+                   slopes[idx] * (h * (t - 6 * t3 + 8 * t4 - 3 * t5)) +
+                   curve0 * (h * h * (t2 - 3 * t3 + 3 * t4 - t5) / 2) +
+                   curve1 * (h * h * (t3 - 2 * t4 + t5) / 2) +
+                   slopes[idx + 1] * (h * (7 * t4 - 4 * t3 - 3 * t5)) +
+                   values[idx + 1] * (10 * t3 - 15 * t4 + 6 * t5);
+        }
+    };
+
+    /**
+     * @brief worst-case deviation of FRESNEL_TABLE interpolation from the power series
+     */
+    struct FresnelAccuracy {
+        int size;          // FRESNEL_TABLE_SIZE
+        int order;         // FRESNEL_TABLE_ORDER
+        int bytes;         // memory used by the table
+        double maxError;   // largest |F_table(s) - F(s)| found
+        double worstArg;   // s at which maxError occurs
+    };
+
+    extern const FresnelTable<FRESNEL_TABLE_SIZE, FRESNEL_TABLE_ORDER> FRESNEL_TABLE;
+    extern const FresnelTable<FRESNEL_NARROW_TABLE_SIZE, FRESNEL_TABLE_ORDER, float, FRESNEL_NARROW_TABLE_MAX>
+            FRESNEL_TABLE_FLOAT;
+    extern const FresnelTable<FRESNEL_NARROW_TABLE_SIZE, FRESNEL_TABLE_ORDER, Fixed, FRESNEL_NARROW_TABLE_MAX>
+            FRESNEL_TABLE_FIXED;
+
+    /**
+     * @brief does nothing. FRESNEL_TABLE is generated at compile time; this is kept for compatibility.
+     */
     extern void init_fresnel();
+
+    /*
+     * The Fresnel integrals C(s) = int_0^s cos(pi x^2 / 2) dx and S(s) = int_0^s sin(pi x^2 / 2) dx for any real s.
+     *  |s| <= 1:                         interpolation of FRESNEL_TABLE, absolute error < 5e-10 with the defaults
+     *  1 < |s| <= FRESNEL_SERIES_MAX:   power series, absolute error < 1e-14
+     *  FRESNEL_SERIES_MAX < |s| < FRESNEL_ASYMPTOTIC_MIN: continued fraction (rational), absolute error < 1e-14
+     *  |s| >= FRESNEL_ASYMPTOTIC_MIN:    asymptotic expansion of the auxiliary functions, absolute error < 1e-12
+     * Negative arguments use C(-s) = -C(s) and S(-s) = -S(s).
+     */
     extern double fresnel_C(double s);
     extern double fresnel_S(double s);
     extern Vector2 fresnel_vec(double s);
+
+    /**
+     * @brief (C(s), S(s)) in float or Fixed, without any double arithmetic. |s| <= FRESNEL_NARROW_TABLE_MAX
+     * interpolates the table of the same type, absolute error < 3e-7 for float and < 5e-5 for Fixed with the defaults;
+     * larger arguments use the asymptotic expansion in the same type.
+     */
+    extern BasicVector2<float> fresnel_vec(float s);
+    extern BasicVector2<Fixed> fresnel_vec(Fixed s);
+
+    /**
+     * @brief measure the accuracy of the configured table against the power series
+     * @param samples number of evenly spaced arguments on [0, 1] to check
+     * @return table configuration and worst error found
+     */
+    extern FresnelAccuracy fresnel_table_accuracy(int samples = 100000);
 }
 #endif //VEX_PATH_PLANNER_FRESNEL_H
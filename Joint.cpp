@@ -11,9 +11,44 @@ namespace path {
         this->update();
     }
 
-    void Joint::update() {
+    /**
+     * @brief whether two unit vectors point the same way, up to rounding
+     */
+    static bool same_direction(Vector2 a, Vector2 b) {
+        return std::fabs(a.cross(b)) < 1e-12 && a.dot(b) > 0;
+    }
+
+    unsigned Joint::update() {
         auto e1 = (*pMiddle - *pStart).normalize();
         auto e2 = (*pEnd - *pMiddle).normalize();
+
+        unsigned dirty = JOINT_CLEAN;
+        if (!this->configured || *this->pMiddle != this->lastMiddle) {
+            dirty = JOINT_ALL;
+        } else {
+            if (*this->pStart != this->lastStart)
+                dirty |= same_direction(e1, this->lastE1) ? JOINT_LINE1 : JOINT_ALL;
+            if (*this->pEnd != this->lastEnd)
+                dirty |= same_direction(e2, this->lastE2) ? JOINT_LINE2 : JOINT_ALL;
+        }
+
+        this->lastStart = *this->pStart;
+        this->lastMiddle = *this->pMiddle;
+        this->lastEnd = *this->pEnd;
+        this->configured = true;
+
+        if (!(dirty & JOINT_CORNER)) {
+            if (dirty & JOINT_LINE1)
+                this->line1.set_start(*this->pStart);
+            if (dirty & JOINT_LINE2)
+                this->line2.set_end(*this->pEnd);
+            return dirty;
+        }
+
+        // keep the directions the corner was built from so slow drags along a leg don't accumulate
+        this->lastE1 = e1;
+        this->lastE2 = e2;
+
         auto delta0 = e1.heading();
         auto delta = e1.oriented_angle(e2);
         auto deltaAbs = fabs(delta);
@@ -47,7 +82,7 @@ namespace path {
             }
         } else {
             length = sqrt(fabs(delta) / sharpness);
-            auto tmp = fresnel_vec(deltaAbs / M_PI) * sqrt(M_PI / this->sharpness);
+            auto tmp = fresnel_vec(sqrt(deltaAbs / M_PI)) * sqrt(M_PI / this->sharpness);
             d = tmp.x + tmp.y * tan(deltaAbs / 2);
             this->arc.set_visibility(false);
         }
@@ -59,19 +94,104 @@ namespace path {
         this->clothoid2.configure(clothoid2Start, delta0 + delta + M_PI, length, -sharpness * sign(delta), 0, true);
         this->line1.configure(*this->pStart, clothoid1Start);
         this->line2.configure(clothoid2Start, *this->pEnd);
+        return dirty;
     }
 
-    std::vector<Vector2> Joint::get_waypoints(double ds) const {
-        std::vector<Vector2> res;
+    void Joint::invalidate() {
+        this->configured = false;
+    }
+
+    void Joint::get_waypoints(WaypointBuffer& output, double ds) const {
         auto length = line1.get_length() + this->line2.get_length() + this->clothoid1.get_length() +
                       this->clothoid2.get_length() + this->arc.get_length();
-        res.reserve((unsigned long)(length / ds) + 8 + this->arc.is_visible() * 2);
-        this->line1.get_waypoints_spaced(res, ds);
-        this->clothoid1.get_waypoints_spaced(res, ds);
+        output.reserve(output.size() + (unsigned long)(length / ds) + 8 + this->arc.is_visible() * 2);
+
+        if (!output.is_fixed()) {
+            // reuse each curve's cached span; only curves changed since the last call are resampled
+            this->line1.append_cached_waypoints(output, ds);
+            this->clothoid1.append_cached_waypoints(output, ds);
+            if (this->arc.is_visible())
+                this->arc.append_cached_waypoints(output, ds);
+            this->clothoid2.append_cached_waypoints(output, ds);
+            this->line2.append_cached_waypoints(output, ds);
+            return;
+        }
+
+        this->line1.get_waypoints_spaced(output, ds);
+        this->clothoid1.get_waypoints_spaced(output, ds);
+        if (this->arc.is_visible())
+            this->arc.get_waypoints_spaced(output, ds);
+        this->clothoid2.get_waypoints_spaced(output, ds);
+        this->line2.get_waypoints_spaced(output, ds);
+    }
+
+    bool Joint::get_waypoints_into(WaypointBuffer& output, double ds) const noexcept {
+        // an owning buffer may allocate, which could throw
+        if (!output.is_fixed())
+            return false;
+        this->get_waypoints(output, ds);
+        return !output.truncated();
+    }
+
+    std::vector<Vector2> Joint::get_waypoints(double ds) const {
+        WaypointBuffer buffer;
+        this->get_waypoints(buffer, ds);
+        return buffer.positions();
+    }
+
+    void Joint::get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const {
+        this->line1.get_waypoints_adaptive(output, tolerance, dsMax);
+        this->clothoid1.get_waypoints_adaptive(output, tolerance, dsMax);
+        if (this->arc.is_visible())
+            this->arc.get_waypoints_adaptive(output, tolerance, dsMax);
+        this->clothoid2.get_waypoints_adaptive(output, tolerance, dsMax);
+        this->line2.get_waypoints_adaptive(output, tolerance, dsMax);
+    }
+
+    void Joint::get_corner_waypoints(WaypointBuffer& output, double ds) const {
+        this->clothoid1.get_waypoints_spaced(output, ds);
         if (this->arc.is_visible())
-            this->arc.get_waypoints_spaced(res, ds);
-        this->clothoid2.get_waypoints_spaced(res, ds);
-        this->line2.get_waypoints_spaced(res, ds);
-        return res;
+            this->arc.get_waypoints_spaced(output, ds);
+        this->clothoid2.get_waypoints_spaced(output, ds);
+    }
+
+    Projection Joint::get_lookahead(Vector2 robot, double lookahead, LookaheadCursor& cursor) const {
+        const Curve* curves[5];
+        std::size_t numCurves = 0;
+        curves[numCurves++] = &this->line1;
+        curves[numCurves++] = &this->clothoid1;
+        if (this->arc.is_visible())
+            curves[numCurves++] = &this->arc;
+        curves[numCurves++] = &this->clothoid2;
+        curves[numCurves++] = &this->line2;
+
+        if (!find_lookahead(curves, numCurves, robot, lookahead, cursor))
+            cursor = {numCurves - 1, this->line2.get_length()};
+
+        auto s = cursor.s;
+        for (std::size_t i = 0; i < cursor.curve; ++i)
+            s += curves[i]->get_length();
+        auto point = curves[cursor.curve]->get_travel_point(cursor.s);
+        return {s, point, (point - robot).norm()};
+    }
+
+    const Line& Joint::get_line1() const {
+        return this->line1;
+    }
+
+    const Clothoid& Joint::get_clothoid1() const {
+        return this->clothoid1;
+    }
+
+    const CircularArc& Joint::get_arc() const {
+        return this->arc;
+    }
+
+    const Clothoid& Joint::get_clothoid2() const {
+        return this->clothoid2;
+    }
+
+    const Line& Joint::get_line2() const {
+        return this->line2;
     }
 } // path
\ No newline at end of file
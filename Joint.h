@@ -11,18 +11,97 @@
 #include "Line.h"
 
 namespace path {
+    /**
+     * @brief parts of a joint changed by Joint::update
+     */
+    enum JointPart : unsigned {
+        JOINT_CLEAN = 0,
+        JOINT_LINE1 = 1,  // line1 only
+        JOINT_CORNER = 2, // clothoid1, arc, clothoid2, and the inner ends of both lines
+        JOINT_LINE2 = 4,  // line2 only
+        JOINT_ALL = JOINT_LINE1 | JOINT_CORNER | JOINT_LINE2
+    };
+
     class Joint {
     public:
         Joint(Vector2 *pStart, Vector2 *pMiddle, Vector2 *pEnd, double sharpness, double maxCurvature);
 
-        void update();
+        /**
+         * @brief bring the joint up to date with its control points, recomputing only what they affect.
+         * The turn depends on pMiddle and the directions of both legs. Moving pStart or pEnd along its leg only
+         * stretches line1 or line2; any other move reshapes the corner.
+         * @return JointPart flags of what changed, JOINT_CLEAN if nothing moved
+         */
+        unsigned update();
+
+        /**
+         * @brief force the next update() to recompute everything
+         */
+        void invalidate();
+
+        /**
+         * @brief sample the joint: line, clothoid, arc (if visible), clothoid, line.
+         * An owning buffer is filled from each curve's cached waypoints; a fixed buffer is sampled directly.
+         * @param output buffer to add waypoints to
+         * @param ds space between waypoints
+         */
+        void get_waypoints(WaypointBuffer& output, double ds) const;
+
+        /**
+         * @brief sample the joint into a fixed-capacity buffer without allocating or throwing
+         * @param output buffer over caller storage (output.is_fixed())
+         * @param ds space between waypoints
+         * @return whether every waypoint fit. False without sampling if output is not fixed.
+         */
+        bool get_waypoints_into(WaypointBuffer& output, double ds) const noexcept;
         std::vector<Vector2> get_waypoints(double ds) const;
 
+        /**
+         * @brief sample the joint with curvature-adaptive spacing, see Curve::get_waypoints_adaptive
+         * @param output buffer to add waypoints to
+         * @param tolerance maximum chord deviation
+         * @param dsMax maximum space between waypoints
+         */
+        void get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const;
+
+        /**
+         * @brief sample only the turn: clothoid, arc (if visible), clothoid. Used when the lines are shared with
+         * neighbouring joints.
+         * @param output buffer to add waypoints to
+         * @param ds space between waypoints
+         */
+        void get_corner_waypoints(WaypointBuffer& output, double ds) const;
+
+        /**
+         * @brief pure pursuit lookahead point on the joint, see Path::get_lookahead
+         * @param robot robot position
+         * @param lookahead lookahead distance
+         * @param cursor where the previous cycle's search stopped, indexing line1, clothoid1, arc (if visible),
+         * clothoid2, line2
+         * @return the lookahead point with s measured from the start of line1, or the end of line2 if no point ahead
+         * is far enough away
+         */
+        [[nodiscard]] Projection get_lookahead(Vector2 robot, double lookahead, LookaheadCursor& cursor) const;
+
+        [[nodiscard]] const Line& get_line1() const;
+        [[nodiscard]] const Clothoid& get_clothoid1() const;
+        [[nodiscard]] const CircularArc& get_arc() const;
+        [[nodiscard]] const Clothoid& get_clothoid2() const;
+        [[nodiscard]] const Line& get_line2() const;
+
     private:
         Vector2* pStart;
         Vector2* pMiddle;
         Vector2* pEnd;
 
+        // control points and leg directions as of the last update()
+        Vector2 lastStart;
+        Vector2 lastMiddle;
+        Vector2 lastEnd;
+        Vector2 lastE1;
+        Vector2 lastE2;
+        bool configured = false;
+
         Vector2 pCurvatureControl;
         Vector2 pSharpnessControl1;
         Vector2 pSharpnessControl2;
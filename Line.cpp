@@ -3,6 +3,7 @@
 //
 
 #include "Line.h"
+#include <algorithm>
 
 namespace path {
     Line::Line(path::Vector2 start, path::Vector2 end, bool visible):
@@ -15,17 +16,75 @@ namespace path {
         return start + (end - start).normalize() * s;
     }
 
-    void Line::get_waypoints(std::vector<path::Vector2>& output, int numWaypoints) const {
-        map_interval<double, Vector2>(output, [this](double s) -> Vector2 {
-            return lerp<double, Vector2>(this->start, this->end, s);
-        }, 0, 1, numWaypoints);
+    void Line::get_waypoints(WaypointBuffer& output, int numWaypoints) const {
+        auto s0 = output.length();
+        auto length = this->get_length();
+        auto theta = (this->end - this->start).heading();
+
+        if (output.capacity() - output.size() < (std::size_t)numWaypoints)
+            output.reserve(output.size() + numWaypoints);
+
+        for (int i = 0; i < numWaypoints; ++i) {
+            auto t = numWaypoints > 1 ? (double)i / (numWaypoints - 1) : 0;
+            output.push_back(lerp<double, Vector2>(this->start, this->end, t), theta, 0, s0 + length * t);
+        }
     }
 
-    void Line::get_waypoints_spaced(std::vector<path::Vector2>& output, double ds) const {
+    void Line::get_waypoints_spaced(WaypointBuffer& output, double ds) const {
+        auto s0 = output.length();
+        auto length = this->get_length();
         auto unitVec = (end - start).normalize();
-        map_interval_spaced<double, Vector2>(output, [this, unitVec](double s) -> Vector2 {
-            return this->start + unitVec * s;
-        }, 0, (this->end - this->start).norm(), ds);
+        auto theta = unitVec.heading();
+        auto steps = (int)(length / ds);
+        bool useEnd = length - steps * ds > 0.001;
+
+        auto numAdded = (std::size_t)steps + useEnd + 1;
+        if (output.capacity() - output.size() < numAdded)
+            output.reserve(output.size() + numAdded);
+
+        for (int i = 0; i <= steps; ++i)
+            output.push_back(this->start + unitVec * (ds * i), theta, 0, s0 + ds * i);
+
+        if (useEnd)
+            output.push_back(this->end, theta, 0, s0 + length);
+    }
+
+    void Line::get_waypoints_adaptive(WaypointBuffer& output, double, double dsMax) const {
+        // straight, so there is no chord deviation and only the spacing cap applies
+        auto steps = std::max((int)std::ceil(this->get_length() / dsMax), 1);
+        this->get_waypoints(output, steps + 1);
+    }
+
+    bool Line::intersect_circle(Vector2 center, double radius, double sMin, double& s) const {
+        auto length = this->get_length();
+        if (length == 0)
+            return false;
+
+        // |start + u t - center|^2 = radius^2  =>  t^2 + 2 b t + c = 0
+        auto u = (this->end - this->start) / length;
+        auto offset = this->start - center;
+        auto b = offset.dot(u);
+        auto c = offset.norm_squared() - radius * radius;
+        auto discriminant = b * b - c;
+        if (discriminant < 0)
+            return false;
+
+        auto root = std::sqrt(discriminant);
+        for (auto t: {-b - root, -b + root}) {
+            if (t >= sMin && t <= length) {
+                s = t;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    BoundingBox Line::get_bounding_box(double s0, double s1) const {
+        auto length = this->get_length();
+        auto direction = length > 0 ? (this->end - this->start) / length : Vector2(0, 0);
+        BoundingBox box(this->start + direction * std::clamp(s0, 0.0, length));
+        box.expand(this->start + direction * std::clamp(s1, 0.0, length));
+        return box;
     }
 
     Vector2 Line::get_start() const {
@@ -40,15 +99,36 @@ namespace path {
         return (this->end - this->start).norm();
     }
 
+    double Line::get_heading(double) const {
+        return (this->end - this->start).heading();
+    }
+
+    double Line::get_curvature(double) const {
+        return 0;
+    }
+
+    Projection Line::project(Vector2 p) const {
+        auto length = this->get_length();
+        if (length == 0)
+            return {0, this->start, (p - this->start).norm()};
+
+        auto s = std::clamp((p - this->start).dot(this->end - this->start) / length, 0.0, length);
+        auto point = lerp<double, Vector2>(this->start, this->end, s / length);
+        return {s, point, (p - point).norm()};
+    }
+
     void Line::set_start(path::Vector2 pos) {
+        this->invalidate_cache();
         this->start = pos;
     }
 
     void Line::set_end(path::Vector2 pos) {
+        this->invalidate_cache();
         this->end = pos;
     }
 
     void Line::configure(path::Vector2 a, path::Vector2 b) {
+        this->invalidate_cache();
         this->start = a;
         this->end = b;
     }
@@ -20,25 +20,64 @@ namespace path {
          */
         [[nodiscard]] Vector2 get_point(double s) const override;
 
+        using Curve::get_waypoints;
+        using Curve::get_waypoints_spaced;
+
         /**
-         * @param output vector to add points to
+         * @param output buffer to add waypoints to
          * @param numWaypoints number of waypoints
-         * @return list of waypoints
          */
-        void get_waypoints(std::vector<path::Vector2>& output, int numWaypoints) const override;
+        void get_waypoints(WaypointBuffer& output, int numWaypoints) const override;
 
         /**
-         * @param output vector to add points to
+         * @param output buffer to add waypoints to
          * @param ds step size
-         * @return list of waypoints
          */
-        void get_waypoints_spaced(std::vector<path::Vector2>& output, double ds) const override;
+        void get_waypoints_spaced(WaypointBuffer& output, double ds) const override;
+
+        /**
+         * @brief evenly spaced waypoints, as few as dsMax allows
+         * @param output buffer to add waypoints to
+         * @param tolerance maximum chord deviation, unused since a line's chords never deviate
+         * @param dsMax maximum space between waypoints
+         */
+        void get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const override;
 
         [[nodiscard]] Vector2 get_start() const;
         [[nodiscard]] Vector2 get_end() const;
 
         [[nodiscard]] double get_length() const override;
 
+        [[nodiscard]] double get_heading(double s) const override;
+        [[nodiscard]] double get_curvature(double s) const override;
+
+        /**
+         * @brief project onto the segment by clamping the scalar projection onto its direction
+         * @param p query point
+         * @return closest point
+         */
+        [[nodiscard]] Projection project(Vector2 p) const override;
+
+        /**
+         * @brief first circle-line intersection, solved as a quadratic in s
+         * @param center center of the circle
+         * @param radius radius of the circle
+         * @param sMin arc length to start searching from
+         * @param s set to the arc length of the intersection, if any
+         * @return whether the curve meets the circle at or after sMin
+         */
+        bool intersect_circle(Vector2 center, double radius, double sMin, double& s) const override;
+
+        using Curve::get_bounding_box;
+
+        /**
+         * @brief box spanned by the two end points of the part
+         * @param s0 arc length along the direction of travel where the part starts
+         * @param s1 arc length along the direction of travel where the part ends
+         * @return bounding box of the part
+         */
+        [[nodiscard]] BoundingBox get_bounding_box(double s0, double s1) const override;
+
         void set_start(Vector2 pos);
         void set_end(Vector2 pos);
         void configure(Vector2 a, Vector2 b);
@@ -15,14 +15,15 @@ namespace path {
      * @brief approximate integral using Simpson's Rule.
      * @tparam I input type, also used for integration bounds
      * @tparam O (optional) output type
+     * @tparam F callable as O(I)
      * @param f integrand
      * @param a lower limit of integration
      * @param b upper limit of integration
      * @param steps number of steps
      * @return integral value
      */
-    template <typename I, typename O>
-    O integral(std::function<O(I)> f, I a, I b, int steps) {
+    template <typename I, typename O, typename F>
+    O integral(F&& f, I a, I b, int steps) {
         steps *= 2;
         I dx = (b - a) / steps;
         O sum = f(a);
@@ -34,11 +35,20 @@ namespace path {
         return dx / 3 * sum;
     }
 
+    /**
+     * @brief std::function overload of integral
+     */
+    template <typename I, typename O>
+    O integral(const std::function<O(I)>& f, I a, I b, int steps) {
+        return integral<I, O, const std::function<O(I)>&>(f, a, b, steps);
+    }
+
     /**
      * @brief approximate integral on all ranges [a, a], [a, a+dx], [a + 2dx], ..., up to [a, b] using Simpson's Rule.
      * @param output vector to add points to
      * @tparam I input type, also used for integration bounds
      * @tparam O (optional) output type
+     * @tparam F callable as O(I)
      * @param f integrand
      * @param a lower limit of integration
      * @param b upper limit of integration
@@ -46,12 +56,12 @@ namespace path {
      * @param start (optional) used as the initial sum before computing the integral
      * @return a list of integral results for each sub-interval
      */
-    template <typename I, typename O>
-    void moving_integral(std::vector<O>& output, std::function<O(I)> f, I a, I b, int steps, O start = O()) {
+    template <typename I, typename O, typename F>
+    void moving_integral(std::vector<O>& output, F&& f, I a, I b, int steps, O start = O()) {
         O next = f(a); // used to avoid needing to recompute f(x)
 
         O sum = start;
-        if (output.capacity() - output.size() < steps)
+        if (output.capacity() - output.size() < (std::size_t)steps)
             output.reserve(output.size() + steps);
         output.emplace_back(sum);
 
@@ -69,10 +79,19 @@ namespace path {
         }
     }
 
+    /**
+     * @brief std::function overload of moving_integral
+     */
+    template <typename I, typename O>
+    void moving_integral(std::vector<O>& output, const std::function<O(I)>& f, I a, I b, int steps, O start = O()) {
+        moving_integral<I, O, const std::function<O(I)>&>(output, f, a, b, steps, start);
+    }
+
     /**
      * @brief approximate integral on all ranges [a, a], [a, a+dx], [a + 2dx], ..., up to [a, b] using Simpson's Rule.
      * @tparam I input type, also used for integration bounds
      * @tparam O (optional) output type
+     * @tparam F callable as O(I)
      * @param f integrand
      * @param a lower limit of integration
      * @param b upper limit of integration
@@ -80,80 +99,104 @@ namespace path {
      * @param start (optional) used as the initial sum before computing the integral
      * @return a list of integral results for each sub-interval
      */
-    template <typename I, typename O>
-    std::vector<O> moving_integral(std::function<O(I)> f, I a, I b, int steps, O start = O()) {
+    template <typename I, typename O, typename F>
+    std::vector<O> moving_integral(F&& f, I a, I b, int steps, O start = O()) {
         std::vector<O> res;
-        moving_integral<I, O>(res, f, a, b, steps, start);
+        moving_integral<I, O>(res, std::forward<F>(f), a, b, steps, start);
         return res;
     }
 
+    /**
+     * @brief std::function overload of moving_integral
+     */
+    template <typename I, typename O>
+    std::vector<O> moving_integral(const std::function<O(I)>& f, I a, I b, int steps, O start = O()) {
+        return moving_integral<I, O, const std::function<O(I)>&>(f, a, b, steps, start);
+    }
+
     /**
      * @brief approximate integral on all ranges [a, a], [a, a+dx], [a + 2dx], ..., up to [a, b] using Simpson's Rule.
      * @tparam I input type, also used for integration bounds
      * @tparam O (optional) output type
+     * @tparam F callable as O(I)
      * @param f integrand
      * @param a lower limit of integration
-     * @param b upper limit of integration
-     * @param dx number of steps
+     * @param b upper limit of integration, may be below a
+     * @param dx space between outputs; its sign is ignored
      * @param start (optional) used as the initial sum before computing the integral
      * @return a list of integral results for each sub-interval
      */
-    template <typename I, typename O>
-    void moving_integral_spaced(std::vector<O>& output, std::function<O(I)> f, I a, I b, I dx, O start = O()) {
-        if (b < a) {
-            auto tmp = a;
-            a = b;
-            b = tmp;
-            dx = -dx;
-        }
-        O next = f(a); // used to avoid needing to recompute f(x)
-        int steps = ( (b - a) / fabs(dx) ) * 2;
-        bool useEnd = fabs(dx * steps - b) > 0.001;
+    template <typename I, typename O, typename F>
+    void moving_integral_spaced(std::vector<O>& output, F&& f, I a, I b, I dx, O start = O()) {
+        using std::fabs;
+        // step from a towards b, so a reversed interval gives the integrals over [a, x] for decreasing x
+        dx = b < a ? -fabs(dx) : fabs(dx);
+        int panels = (int)((b - a) / dx);
+        I last = a + dx * panels;
+        bool useEnd = fabs(b - last) > I(0.001);
 
+        O next = f(a); // used to avoid needing to recompute f(x)
         dx /= 2;
         I dx_3 = dx / 3;
 
         O sum = start / dx_3;
 
-        auto numAdded = steps / 2 + useEnd + 1;
+        auto numAdded = (std::size_t)panels + useEnd + 1;
         if (output.capacity() - output.size() < numAdded)
             output.reserve(output.size() + numAdded);
         output.emplace_back(start);
 
-        for (int i = 1; i < steps; ++i) {
-            sum += next + f(a + i * dx) * 4;
-            next = f(a + (++i) * dx);
+        for (int k = 0; k < panels; ++k) {
+            sum += next + f(a + (2 * k + 1) * dx) * 4;
+            next = f(a + (2 * k + 2) * dx);
             sum += next;
             output.emplace_back(sum * dx_3);
         }
 
         if (useEnd) {
-            // use a smaller window for the last point
+            // use a smaller window for the last point, over [last, b]
             sum *= dx_3;
-            dx = (b - steps * dx) / 2;
+            dx = (b - last) / 2;
             sum += (next + f(b - dx) * 4 + f(b)) * dx / 3;
             output.emplace_back(sum);
         }
     }
 
+    /**
+     * @brief std::function overload of moving_integral_spaced
+     */
+    template <typename I, typename O>
+    void moving_integral_spaced(std::vector<O>& output, const std::function<O(I)>& f, I a, I b, I dx, O start = O()) {
+        moving_integral_spaced<I, O, const std::function<O(I)>&>(output, f, a, b, dx, start);
+    }
+
     /**
      * @brief approximate integral on all ranges [a, a], [a, a+dx], [a + 2dx], ..., up to [a, b] using Simpson's Rule.
      * @tparam I input type, also used for integration bounds
      * @tparam O (optional) output type
+     * @tparam F callable as O(I)
      * @param f integrand
      * @param a lower limit of integration
-     * @param b upper limit of integration
-     * @param dx number of steps
+     * @param b upper limit of integration, may be below a
+     * @param dx space between outputs; its sign is ignored
      * @param start (optional) used as the initial sum before computing the integral
      * @return a list of integral results for each sub-interval
      */
-    template <typename I, typename O>
-    std::vector<O> moving_integral_spaced(std::function<O(I)> f, I a, I b, I dx, O start = O()) {
+    template <typename I, typename O, typename F>
+    std::vector<O> moving_integral_spaced(F&& f, I a, I b, I dx, O start = O()) {
         std::vector<O> res;
-        moving_integral_spaced(res, f, a, b, dx, start);
+        moving_integral_spaced<I, O>(res, std::forward<F>(f), a, b, dx, start);
         return res;
     }
 
+    /**
+     * @brief std::function overload of moving_integral_spaced
+     */
+    template <typename I, typename O>
+    std::vector<O> moving_integral_spaced(const std::function<O(I)>& f, I a, I b, I dx, O start = O()) {
+        return moving_integral_spaced<I, O, const std::function<O(I)>&>(f, a, b, dx, start);
+    }
+
     /**
      * @brief linear interpolation between a and b at time t
      * @tparam I (optional) type of time parameter
@@ -173,20 +216,22 @@ namespace path {
      * @param output vector to add points to
      * @tparam I input type
      * @tparam O output type
+     * @tparam F callable as O(I)
      * @param f function
      * @param a start x
      * @param b end x
      * @param dx step size
      */
-    template <typename I, typename O = I>
-    void map_interval_spaced(std::vector<O>& output, std::function<O(I)> f, I a, I b, I dx) {
+    template <typename I, typename O = I, typename F>
+    void map_interval_spaced(std::vector<O>& output, F&& f, I a, I b, I dx) {
         if (b < a)
             dx = -dx;
 
-        int steps = (b - a) / dx; // any negatives should cancel out
-        bool useEnd = fabs(dx * steps - b) > 0.001;
+        using std::fabs;
+        int steps = (int)((b - a) / dx); // any negatives should cancel out
+        bool useEnd = fabs(a + dx * steps - b) > I(0.001);
 
-        if (output.capacity() - output.size() < steps + useEnd + 1)
+        if (output.capacity() - output.size() < (std::size_t)(steps + useEnd + 1))
             output.reserve(output.size() + steps + useEnd + 1);
 
         for (int i = 0; i <= steps; ++i)
@@ -196,36 +241,54 @@ namespace path {
             output.emplace_back(f(b));
     }
 
+    /**
+     * @brief std::function overload of map_interval_spaced
+     */
+    template <typename I, typename O = I>
+    void map_interval_spaced(std::vector<O>& output, const std::function<O(I)>& f, I a, I b, I dx) {
+        map_interval_spaced<I, O, const std::function<O(I)>&>(output, f, a, b, dx);
+    }
+
     /**
      * @brief maps an interval with a function
      * @tparam I input type
      * @tparam O output type
+     * @tparam F callable as O(I)
      * @param f function
      * @param a start x
      * @param b end x
      * @param dx step size
      * @return function output on the interval
      */
-    template <typename I, typename O = I>
-    std::vector<O> map_interval_spaced(std::function<O(I)> f, I a, I b, I dx) {
+    template <typename I, typename O = I, typename F>
+    std::vector<O> map_interval_spaced(F&& f, I a, I b, I dx) {
         std::vector<O> output;
-        map_interval_spaced<I, O>(output, f, a, b, dx);
+        map_interval_spaced<I, O>(output, std::forward<F>(f), a, b, dx);
         return output;
     }
 
+    /**
+     * @brief std::function overload of map_interval_spaced
+     */
+    template <typename I, typename O = I>
+    std::vector<O> map_interval_spaced(const std::function<O(I)>& f, I a, I b, I dx) {
+        return map_interval_spaced<I, O, const std::function<O(I)>&>(f, a, b, dx);
+    }
+
     /**
      * @brief maps an interval with a function
      * @param output vector to add points to
      * @tparam I input type
      * @tparam O output type
+     * @tparam F callable as O(I)
      * @param f function
      * @param a start x
      * @param b end x
      * @param steps number of points evaluated
      */
-    template <typename I, typename O = I>
-    void map_interval(std::vector<O>& output, std::function<O(I)> f, I a, I b, int steps) {
-        if (output.capacity() - output.size() < steps)
+    template <typename I, typename O = I, typename F>
+    void map_interval(std::vector<O>& output, F&& f, I a, I b, int steps) {
+        if (output.capacity() - output.size() < (std::size_t)steps)
             output.reserve(output.size() + steps);
         I dx = (b - a) / (steps - 1);
 
@@ -233,28 +296,259 @@ namespace path {
             output.emplace_back(f(a + dx * i));
     }
 
+    /**
+     * @brief std::function overload of map_interval
+     */
+    template <typename I, typename O = I>
+    void map_interval(std::vector<O>& output, const std::function<O(I)>& f, I a, I b, int steps) {
+        map_interval<I, O, const std::function<O(I)>&>(output, f, a, b, steps);
+    }
+
     /**
      * @brief maps an interval with a function
      * @tparam I input type
      * @tparam O output type
+     * @tparam F callable as O(I)
      * @param f function
      * @param a start x
      * @param b end x
      * @param steps number of points evaluated
      * @return function output on the interval
      */
-    template <typename I, typename O = I>
-    std::vector<O> map_interval(std::function<O(I)> f, I a, I b, int steps) {
+    template <typename I, typename O = I, typename F>
+    std::vector<O> map_interval(F&& f, I a, I b, int steps) {
         std::vector<O> res;
-        map_interval<I, O>(res, f, a, b, steps);
+        map_interval<I, O>(res, std::forward<F>(f), a, b, steps);
         return res;
     }
 
+    /**
+     * @brief std::function overload of map_interval
+     */
+    template <typename I, typename O = I>
+    std::vector<O> map_interval(const std::function<O(I)>& f, I a, I b, int steps) {
+        return map_interval<I, O, const std::function<O(I)>&>(f, a, b, steps);
+    }
+
     template <typename T>
     T sign(T x) {
         return x > 0 ? 1 : x < 0 ? -1 : 0;
     }
 
+    /**
+     * @brief sine by its Taylor series, usable in constant expressions. There is no range reduction, so keep |x| small
+     * (|x| <= pi gives full double precision).
+     * @tparam T scalar type
+     * @param x angle in radians
+     * @return sin(x)
+     */
+    template <typename T>
+    constexpr T sin_series(T x) {
+        T term = x;
+        T sum = 0;
+        for (int n = 1; n < 40 && sum + term != sum; n += 2) {
+            sum += term;
+            term *= -x * x / ((n + 1) * (n + 2));
+        }
+        return sum;
+    }
+
+    /**
+     * @brief cosine by its Taylor series, usable in constant expressions. There is no range reduction, so keep |x|
+     * small (|x| <= pi gives full double precision).
+     * @tparam T scalar type
+     * @param x angle in radians
+     * @return cos(x)
+     */
+    template <typename T>
+    constexpr T cos_series(T x) {
+        T term = 1;
+        T sum = 0;
+        for (int n = 0; n < 40 && sum + term != sum; n += 2) {
+            sum += term;
+            term *= -x * x / ((n + 1) * (n + 2));
+        }
+        return sum;
+    }
+
+    /**
+     * @brief int_0^1 e^(i u v) dv as (real, imaginary part): the chord of a unit-length arc that turns by u, relative to
+     * its initial heading. Uses the power series near u = 0, where the closed form cancels, and the closed form
+     * elsewhere.
+     * @tparam T scalar type
+     * @param u total turn of the arc
+     * @return the chord as a vector
+     */
+    template <typename T>
+    BasicVector2<T> arc_chord(T u) {
+        using std::fabs, std::cos, std::sin;
+        if (fabs(u) < T(0.5)) {
+            // sum (iu)^n / (n! (n + 1)), 12 terms reach double precision for |u| < 0.5
+            BasicVector2<T> term = {1, 0};
+            BasicVector2<T> sum = {0, 0};
+            for (int n = 0; n < 12; ++n) {
+                sum += term / T(n + 1);
+                term = BasicVector2<T>(-term.y, term.x) * (u / T(n + 1));
+            }
+            return sum;
+        }
+
+        return BasicVector2<T>(sin(u), 1 - cos(u)) / u;
+    }
+
+    /**
+     * @brief int_0^1 v^2 e^(i u v) dv as (real, imaginary part): the first-order change in position along an arc that
+     * turns by u when a small quadratic term is added to its heading. Uses the power series near u = 0, where the
+     * closed form cancels, and the closed form elsewhere.
+     * @tparam T scalar type
+     * @param u total turn of the arc
+     * @return the moment as a vector
+     */
+    template <typename T>
+    BasicVector2<T> arc_moment(T u) {
+        using std::fabs, std::cos, std::sin;
+        if (fabs(u) < T(0.5)) {
+            // sum (iu)^n / (n! (n + 3)), 12 terms reach double precision for |u| < 0.5
+            BasicVector2<T> term = {1, 0};
+            BasicVector2<T> sum = {0, 0};
+            for (int n = 0; n < 12; ++n) {
+                sum += term / T(n + 3);
+                term = BasicVector2<T>(-term.y, term.x) * (u / T(n + 1));
+            }
+            return sum;
+        }
+
+        // e^(iu) (2/u^2 + i (2/u^3 - 1/u)) - 2i/u^3
+        auto inv = T(1) / u;
+        auto inv2 = inv * inv;
+        BasicVector2<T> c = {2 * inv2, (2 * inv2 - 1) * inv};
+        BasicVector2<T> e = {cos(u), sin(u)};
+        return {e.x * c.x - e.y * c.y, e.x * c.y + e.y * c.x - 2 * inv2 * inv};
+    }
+
+    /**
+     * @brief magnitude used by adaptive quadrature to compare error estimates
+     */
+    template <typename T>
+    T error_norm(T x) {
+        using std::fabs;
+        return fabs(x);
+    }
+
+    template <typename T>
+    T error_norm(BasicVector2<T> v) {
+        return v.norm();
+    }
+
+    /**
+     * @brief nodes and weights of the N-point Gauss-Legendre rule on [-1, 1], computed at compile time by Newton's
+     * method on the Legendre polynomial P_N from the Tricomi initial guesses
+     * @tparam N number of nodes
+     */
+    template <int N>
+    struct GaussLegendreRule {
+        static_assert(N >= 1, "a Gauss-Legendre rule needs at least one node");
+
+        double nodes[N] = {};
+        double weights[N] = {};
+
+        constexpr GaussLegendreRule() {
+            for (int i = 0; i < N; ++i) {
+                double x = cos_series(M_PI * (i + 0.75) / (N + 0.5));
+                double dp = 1;
+                for (int iter = 0; iter < 100; ++iter) {
+                    // P_N(x) and P_{N-1}(x) by the three-term recurrence
+                    double p = 1;
+                    double p1 = 0;
+                    for (int k = 1; k <= N; ++k) {
+                        double p2 = p1;
+                        p1 = p;
+                        p = ((2 * k - 1) * x * p1 - (k - 1) * p2) / k;
+                    }
+                    dp = N * (x * p - p1) / (x * x - 1);
+                    double step = p / dp;
+                    x -= step;
+                    if (step < 1e-16 && step > -1e-16)
+                        break;
+                }
+                this->nodes[i] = x;
+                this->weights[i] = 2 / ((1 - x * x) * dp * dp);
+            }
+        }
+    };
+
+    template <int N>
+    inline constexpr GaussLegendreRule<N> GAUSS_LEGENDRE_RULE{};
+
+    /**
+     * @brief quadrature policy: N-point Gauss-Legendre on each of a number of equal panels.
+     * Exact for polynomials of degree 2N - 1 and uses N evaluations per panel.
+     * @tparam N number of nodes per panel
+     */
+    template <int N>
+    struct GaussLegendre {
+        int panels = 1;
+
+        template <typename I, typename O, typename F>
+        O integrate(F&& f, I a, I b) const {
+            const auto& rule = GAUSS_LEGENDRE_RULE<N>;
+            I width = (b - a) / this->panels;
+            I half = width / 2;
+            O sum = O();
+            for (int k = 0; k < this->panels; ++k) {
+                I mid = a + width * k + half;
+                for (int i = 0; i < N; ++i)
+                    sum += f(mid + half * rule.nodes[i]) * rule.weights[i];
+            }
+            return sum * half;
+        }
+    };
+
+    /**
+     * @brief quadrature policy: composite Simpson's rule with a fixed number of steps, see integral
+     */
+    struct SimpsonQuadrature {
+        int steps = 10;
+
+        template <typename I, typename O, typename F>
+        O integrate(F&& f, I a, I b) const {
+            return integral<I, O>(std::forward<F>(f), a, b, this->steps);
+        }
+    };
+
+    /**
+     * @brief quadrature policy: adaptive Simpson's rule. Halves each interval until the Richardson error estimate
+     * of its two halves is below its share of the tolerance, so smooth stretches cost only a few evaluations.
+     */
+    struct AdaptiveSimpson {
+        double tolerance = 1e-10;
+        int maxDepth = 40;
+
+        template <typename I, typename O, typename F>
+        O integrate(F&& f, I a, I b) const {
+            O fa = f(a);
+            O fb = f(b);
+            O fm = f((a + b) / 2);
+            return this->refine<I, O>(f, a, b, fa, fm, fb, (fa + fm * 4 + fb) * ((b - a) / 6), this->tolerance,
+                                      this->maxDepth);
+        }
+
+    private:
+        template <typename I, typename O, typename F>
+        O refine(F& f, I a, I b, O fa, O fm, O fb, O whole, double tol, int depth) const {
+            I m = (a + b) / 2;
+            O flm = f((a + m) / 2);
+            O frm = f((m + b) / 2);
+            O left = (fa + flm * 4 + fm) * ((m - a) / 6);
+            O right = (fm + frm * 4 + fb) * ((b - m) / 6);
+            O diff = left + right - whole;
+            if (depth <= 0 || error_norm(diff) <= 15 * tol)
+                return left + right + diff / 15;
+            return this->refine<I, O>(f, a, m, fa, flm, fm, left, tol / 2, depth - 1) +
+                   this->refine<I, O>(f, m, b, fm, frm, fb, right, tol / 2, depth - 1);
+        }
+    };
+
 } // path
 
 #endif //VEX_PATH_PLANNER_MATHUTILS_H
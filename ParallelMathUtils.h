@@ -0,0 +1,159 @@
+//
+// Created by Benjamin Lee on 8/27/24.
+//
+
+#ifndef VEX_PATH_PLANNER_PARALLELMATHUTILS_H
+#define VEX_PATH_PLANNER_PARALLELMATHUTILS_H
+
+#include <algorithm>
+#include <vector>
+#include "MathUtils.h"
+#include "ThreadPool.h"
+
+// fewer steps than this are integrated serially; splitting them costs more than it saves
+#ifndef PARALLEL_INTEGRAL_MIN_STEPS
+#define PARALLEL_INTEGRAL_MIN_STEPS 16384
+#endif
+
+// smallest number of Simpson panels given to one task
+#ifndef PARALLEL_INTEGRAL_CHUNK
+#define PARALLEL_INTEGRAL_CHUNK 4096
+#endif
+
+namespace path {
+    /**
+     * @brief running Simpson sums over consecutive panels, computed in chunks on a thread pool.
+     * Each chunk sums its own panels from zero, an exclusive scan of the chunk totals gives every chunk its offset and
+     * a second pass adds the offsets. Panel k covers [a + 2k dx, a + 2(k+1) dx].
+     * @param pool workers to run on
+     * @param out out[k] is set to start plus the integral over the first k panels, for k = 0 ... panels
+     * @param f integrand
+     * @param a lower limit of integration
+     * @param dx half the width of a panel
+     * @param panels number of panels
+     * @param start initial sum
+     */
+    template <typename I, typename O, typename F>
+    void simpson_prefix_parallel(ThreadPool& pool, O* out, F& f, I a, I dx, int panels, O start) {
+        I dx_3 = dx / 3;
+        auto numChunks = std::max<std::size_t>(1, std::min<std::size_t>(
+                4 * pool.size(), panels / PARALLEL_INTEGRAL_CHUNK));
+        auto chunkStart = [&](std::size_t c) { return (int)(c * panels / numChunks); };
+
+        // chunk-local sums, in units of dx/3 like the serial version
+        std::vector<O> offsets(numChunks);
+        pool.parallel_for(numChunks, [&](std::size_t c) {
+            O sum = O();
+            O next = f(a + 2 * chunkStart(c) * dx);
+            for (int k = chunkStart(c); k < chunkStart(c + 1); ++k) {
+                sum += next + f(a + (2 * k + 1) * dx) * 4;
+                next = f(a + (2 * k + 2) * dx);
+                sum += next;
+                out[k + 1] = sum;
+            }
+            offsets[c] = sum;
+        });
+
+        // exclusive scan of the chunk totals
+        O offset = start / dx_3;
+        for (auto& chunkOffset: offsets) {
+            O total = chunkOffset;
+            chunkOffset = offset;
+            offset += total;
+        }
+
+        out[0] = start;
+        pool.parallel_for(numChunks, [&](std::size_t c) {
+            for (int k = chunkStart(c); k < chunkStart(c + 1); ++k)
+                out[k + 1] = (out[k + 1] + offsets[c]) * dx_3;
+        });
+    }
+
+    /**
+     * @brief parallel moving_integral. Integrates serially below PARALLEL_INTEGRAL_MIN_STEPS steps or on a single
+     * worker; otherwise the results match the serial version up to floating-point reassociation.
+     * @param pool workers to run on
+     * @param output vector to add points to
+     * @tparam I input type, also used for integration bounds
+     * @tparam O (optional) output type, default constructible to zero
+     * @tparam F callable as O(I), safe to call from several threads at once
+     * @param f integrand
+     * @param a lower limit of integration
+     * @param b upper limit of integration
+     * @param steps number of steps
+     * @param start (optional) used as the initial sum before computing the integral
+     */
+    template <typename I, typename O, typename F>
+    void parallel_moving_integral(ThreadPool& pool, std::vector<O>& output, F&& f, I a, I b, int steps,
+                                  O start = O()) {
+        if (steps < PARALLEL_INTEGRAL_MIN_STEPS || pool.size() < 2) {
+            moving_integral<I, O>(output, std::forward<F>(f), a, b, steps, start);
+            return;
+        }
+
+        I dx = (b - a) / (2 * steps - 2);
+        auto first = output.size();
+        output.resize(first + steps);
+        simpson_prefix_parallel<I, O>(pool, output.data() + first, f, a, dx, steps - 1, start);
+    }
+
+    template <typename I, typename O, typename F>
+    std::vector<O> parallel_moving_integral(ThreadPool& pool, F&& f, I a, I b, int steps, O start = O()) {
+        std::vector<O> res;
+        parallel_moving_integral<I, O>(pool, res, std::forward<F>(f), a, b, steps, start);
+        return res;
+    }
+
+    /**
+     * @brief parallel moving_integral_spaced. Integrates serially below PARALLEL_INTEGRAL_MIN_STEPS steps or on a
+     * single worker; otherwise the results match the serial version up to floating-point reassociation.
+     * @param pool workers to run on
+     * @param output vector to add points to
+     * @tparam I input type, also used for integration bounds
+     * @tparam O (optional) output type, default constructible to zero
+     * @tparam F callable as O(I), safe to call from several threads at once
+     * @param f integrand
+     * @param a lower limit of integration
+     * @param b upper limit of integration, may be below a
+     * @param dx space between outputs; its sign is ignored
+     * @param start (optional) used as the initial sum before computing the integral
+     */
+    template <typename I, typename O, typename F>
+    void parallel_moving_integral_spaced(ThreadPool& pool, std::vector<O>& output, F&& f, I a, I b, I dx,
+                                         O start = O()) {
+        using std::fabs;
+        if (fabs((b - a) / dx) < PARALLEL_INTEGRAL_MIN_STEPS || pool.size() < 2) {
+            moving_integral_spaced<I, O>(output, std::forward<F>(f), a, b, dx, start);
+            return;
+        }
+
+        // same direction, spacing and final partial window as moving_integral_spaced
+        dx = b < a ? -fabs(dx) : fabs(dx);
+        int panels = (int)((b - a) / dx);
+        I last = a + dx * panels;
+        bool useEnd = fabs(b - last) > I(0.001);
+
+        dx /= 2;
+        auto first = output.size();
+        output.resize(first + panels + 1);
+        simpson_prefix_parallel<I, O>(pool, output.data() + first, f, a, dx, panels, start);
+
+        if (useEnd) {
+            // use a smaller window for the last point, over [last, b]
+            O sum = output.back();
+            O next = f(a + 2 * panels * dx);
+            dx = (b - last) / 2;
+            sum += (next + f(b - dx) * 4 + f(b)) * dx / 3;
+            output.emplace_back(sum);
+        }
+    }
+
+    template <typename I, typename O, typename F>
+    std::vector<O> parallel_moving_integral_spaced(ThreadPool& pool, F&& f, I a, I b, I dx, O start = O()) {
+        std::vector<O> res;
+        parallel_moving_integral_spaced<I, O>(pool, res, std::forward<F>(f), a, b, dx, start);
+        return res;
+    }
+} // path
+
+#endif //VEX_PATH_PLANNER_PARALLELMATHUTILS_H
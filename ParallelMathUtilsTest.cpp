@@ -0,0 +1,125 @@
+//
+// Created by Benjamin Lee on 9/6/24.
+//
+
+#include "ParallelMathUtils.h"
+#include <cmath>
+#include <cstdio>
+
+/*
+ * Tolerance test for the moving integrals: the parallel versions against the serial ones, and both against the exact
+ * integral of the unit tangent e^(ix), including intervals that start away from 0, end between two outputs or run
+ * backwards. Each check records the worst error over every output and fails if it exceeds the bound next to it.
+ * Exits with the number of failed checks.
+ */
+
+using namespace path;
+
+namespace {
+    int failures = 0;
+
+    /**
+     * @brief tracks the worst error of one quantity and reports it against its bound
+     */
+    struct Check {
+        const char* name;
+        double bound;
+        double worst = 0;
+        double worstArg = 0;
+
+        Check(const char* name, double bound) : name(name), bound(bound) {}
+
+        void add(double error, double arg) {
+            if (!(error <= this->worst)) {
+                this->worst = error;
+                this->worstArg = arg;
+            }
+        }
+
+        ~Check() {
+            bool ok = this->worst <= this->bound;
+            std::printf("%-4s %-40s worst %.2e (at %g), bound %.0e\n", ok ? "ok" : "FAIL", this->name, this->worst,
+                        this->worstArg, this->bound);
+            if (!ok)
+                ++failures;
+        }
+    };
+
+    Vector2 tangent(double x) {
+        return {std::cos(x), std::sin(x)};
+    }
+
+    /**
+     * @return integral of the unit tangent over [a, x]
+     */
+    Vector2 exact(double a, double x) {
+        return {std::sin(x) - std::sin(a), std::cos(a) - std::cos(x)};
+    }
+
+    /**
+     * @brief moving_integral_spaced, serial and parallel, over [a, b] at spacing dx. Output k is the integral over
+     * [a, a + k dx] (stepping towards b), and the last one ends within 0.001 of b whether or not dx divides b - a.
+     */
+    void test_spaced(ThreadPool& pool, double a, double b, double dx) {
+        std::printf("moving_integral_spaced on [%g, %g], dx %g\n", a, b, dx);
+        auto serial = moving_integral_spaced<double, Vector2>(tangent, a, b, dx);
+        auto parallel = parallel_moving_integral_spaced<double, Vector2>(pool, tangent, a, b, dx);
+
+        Check count("output count, serial vs parallel", 0);
+        count.add(std::fabs((double)serial.size() - (double)parallel.size()), (double)parallel.size());
+        Check last("last output x is b", 0.001);
+        auto step = b < a ? -std::fabs(dx) : std::fabs(dx);
+        last.add(std::fabs(a + step * (double)(serial.size() - 1) - b), (double)serial.size());
+
+        // a final point at b follows the evenly spaced ones unless they end within 0.001 of it
+        Check serialError("serial vs exact", 1e-10);
+        Check parallelError("parallel vs serial", 1e-10);
+        auto panels = (std::size_t)((b - a) / step);
+        for (std::size_t k = 0; k < serial.size(); ++k) {
+            auto x = k <= panels ? a + step * k : b;
+            serialError.add((serial[k] - exact(a, x)).norm(), x);
+            if (k < parallel.size())
+                parallelError.add((parallel[k] - serial[k]).norm(), x);
+        }
+    }
+
+    /**
+     * @brief moving_integral, serial and parallel, over [a, b] in a given number of steps
+     */
+    void test_steps(ThreadPool& pool, double a, double b, int steps) {
+        std::printf("moving_integral on [%g, %g], %d steps\n", a, b, steps);
+        auto serial = moving_integral<double, Vector2>(tangent, a, b, steps);
+        auto parallel = parallel_moving_integral<double, Vector2>(pool, tangent, a, b, steps);
+
+        Check count("output count, serial vs parallel", 0);
+        count.add(std::fabs((double)serial.size() - (double)parallel.size()), (double)parallel.size());
+
+        Check serialError("serial vs exact", 1e-10);
+        Check parallelError("parallel vs serial", 1e-10);
+        auto dx = (b - a) / (steps - 1);
+        for (std::size_t k = 0; k < serial.size(); ++k) {
+            auto x = a + dx * k;
+            serialError.add((serial[k] - exact(a, x)).norm(), x);
+            if (k < parallel.size())
+                parallelError.add((parallel[k] - serial[k]).norm(), x);
+        }
+    }
+}
+
+int main() {
+    ThreadPool pool(4);
+
+    // above PARALLEL_INTEGRAL_MIN_STEPS, so the parallel versions split the work
+    test_spaced(pool, 0, 50, 0.001);
+    test_spaced(pool, 3.7, 61.234, 0.0021);
+    test_spaced(pool, 61.234, 3.7, 0.0021);
+    test_spaced(pool, -20, 15.5, -0.0013);
+    test_steps(pool, 1.5, 30, 40000);
+
+    // below it, so both run the serial code
+    test_spaced(pool, 2.5, 7.3, 0.01);
+    test_spaced(pool, 7.3, 2.5, 0.01);
+
+    std::printf("%d check(s) failed\n", failures);
+    return failures;
+}
@@ -0,0 +1,215 @@
+//
+// Created by Benjamin Lee on 8/26/24.
+//
+
+#include "Path.h"
+#include <algorithm>
+#include <utility>
+
+namespace path {
+    Path::Path(std::vector<Vector2> points, double sharpness, double maxCurvature) :
+            points(std::move(points)),
+            sharpness(sharpness),
+            maxCurvature(maxCurvature) {
+        assert(this->points.size() >= 2);
+
+        this->joints.reserve(this->points.size() - 2);
+        for (std::size_t i = 0; i + 2 < this->points.size(); ++i)
+            this->joints.emplace_back(&this->points[i], &this->points[i + 1], &this->points[i + 2],
+                                      sharpness, maxCurvature);
+        this->segments.resize(this->points.size() - 1);
+        this->update_segments(0, this->joints.size(), JOINT_ALL);
+    }
+
+    Path::Path(const Path& other) : Path(other.points, other.sharpness, other.maxCurvature) {}
+
+    Path& Path::operator=(Path other) noexcept {
+        std::swap(this->points, other.points);
+        std::swap(this->joints, other.joints);
+        std::swap(this->segments, other.segments);
+        std::swap(this->curves, other.curves);
+        std::swap(this->curveStarts, other.curveStarts);
+        std::swap(this->sharpness, other.sharpness);
+        std::swap(this->maxCurvature, other.maxCurvature);
+        std::swap(this->cache, other.cache);
+        return *this;
+    }
+
+    void Path::update() {
+        unsigned dirty = JOINT_CLEAN;
+        for (auto& joint: this->joints)
+            dirty |= joint.update();
+        this->update_segments(0, this->joints.size(), dirty);
+    }
+
+    void Path::set_point(std::size_t i, Vector2 pos) {
+        assert(i < this->points.size());
+        if (this->points[i] == pos)
+            return;
+        this->points[i] = pos;
+
+        // point i is the start, middle and end of joints i, i-1 and i-2 respectively
+        auto first = i < 2 ? 0 : i - 2;
+        auto last = std::min(i + 1, this->joints.size());
+        unsigned dirty = JOINT_CLEAN;
+        for (auto j = first; j < last; ++j)
+            dirty |= this->joints[j].update();
+        this->update_segments(first, last, dirty);
+        std::atomic_store(&this->cache, std::shared_ptr<const CachedWaypoints>());
+    }
+
+    void Path::update_segments(std::size_t first, std::size_t last, unsigned dirty) {
+        if (!this->joints.empty() && dirty == JOINT_CLEAN)
+            return;
+
+        // segment i runs from control point i (or the previous joint's turn) to control point i+1 (or the next turn)
+        for (auto i = first; i <= last && i < this->segments.size(); ++i) {
+            auto start = i == 0 ? this->points.front() : this->joints[i - 1].get_line2().get_start();
+            auto end = i == this->joints.size() ? this->points.back() : this->joints[i].get_line1().get_end();
+            this->segments[i].configure(start, end);
+        }
+
+        // only a corner can show or hide an arc
+        if (dirty & JOINT_CORNER)
+            this->rebuild_curves();
+
+        this->curveStarts.resize(this->curves.size());
+        double length = 0;
+        for (std::size_t i = 0; i < this->curves.size(); ++i) {
+            this->curveStarts[i] = length;
+            length += this->curves[i]->get_length();
+        }
+        std::atomic_store(&this->cache, std::shared_ptr<const CachedWaypoints>());
+    }
+
+    void Path::rebuild_curves() {
+        this->curves.clear();
+        this->curves.push_back(&this->segments[0]);
+        for (std::size_t i = 0; i < this->joints.size(); ++i) {
+            this->curves.push_back(&this->joints[i].get_clothoid1());
+            if (this->joints[i].get_arc().is_visible())
+                this->curves.push_back(&this->joints[i].get_arc());
+            this->curves.push_back(&this->joints[i].get_clothoid2());
+            this->curves.push_back(&this->segments[i + 1]);
+        }
+    }
+
+    void Path::get_waypoints(WaypointBuffer& output, double ds) const {
+        // every curve may add a shorter final step and repeats its neighbour's endpoint
+        output.reserve(output.size() + (std::size_t)(this->get_length() / ds) + 2 * this->curves.size());
+        if (!output.is_fixed()) {
+            for (auto curve: this->curves)
+                curve->append_cached_waypoints(output, ds);
+            return;
+        }
+        for (auto curve: this->curves)
+            curve->get_waypoints_spaced(output, ds);
+    }
+
+    bool Path::get_waypoints_into(WaypointBuffer& output, double ds) const noexcept {
+        // an owning buffer may allocate, which could throw
+        if (!output.is_fixed())
+            return false;
+        this->get_waypoints(output, ds);
+        return !output.truncated();
+    }
+
+    std::vector<Vector2> Path::get_waypoints(double ds) const {
+        WaypointBuffer buffer;
+        this->get_waypoints(buffer, ds);
+        return buffer.positions();
+    }
+
+    void Path::get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const {
+        for (auto curve: this->curves)
+            curve->get_waypoints_adaptive(output, tolerance, dsMax);
+    }
+
+    std::vector<Vector2> Path::get_waypoints_adaptive(double tolerance, double dsMax) const {
+        WaypointBuffer buffer;
+        this->get_waypoints_adaptive(buffer, tolerance, dsMax);
+        return buffer.positions();
+    }
+
+    std::shared_ptr<const WaypointBuffer> Path::get_cached_waypoints(double ds) const {
+        auto cached = std::atomic_load(&this->cache);
+        if (!cached || cached->ds != ds) {
+            auto fresh = std::make_shared<CachedWaypoints>();
+            fresh->ds = ds;
+            this->get_waypoints(fresh->waypoints, ds);
+            cached = std::move(fresh);
+            std::atomic_store(&this->cache, cached);
+        }
+        return {cached, &cached->waypoints};
+    }
+
+    Projection Path::project(Vector2 p) const {
+        std::size_t hint = 0;
+        auto best = this->curves[0]->project(p);
+        for (std::size_t i = 1; i < this->curves.size(); ++i) {
+            auto projection = this->curves[i]->project(p);
+            if (projection.distance < best.distance) {
+                best = projection;
+                hint = i;
+            }
+        }
+        best.s += this->curveStarts[hint];
+        return best;
+    }
+
+    Projection Path::project(Vector2 p, std::size_t& hint) const {
+        hint = std::min(hint, this->curves.size() - 1);
+        auto best = this->curves[hint]->project(p);
+        auto start = hint;
+
+        // ties move forward so zero-length curves between joints are passed over
+        while (hint + 1 < this->curves.size()) {
+            auto projection = this->curves[hint + 1]->project(p);
+            if (projection.distance > best.distance)
+                break;
+            best = projection;
+            ++hint;
+        }
+        while (hint == start && hint > 0) {
+            auto projection = this->curves[hint - 1]->project(p);
+            if (projection.distance >= best.distance)
+                break;
+            best = projection;
+            start = --hint;
+        }
+
+        best.s += this->curveStarts[hint];
+        return best;
+    }
+
+    Projection Path::get_lookahead(Vector2 robot, double lookahead, LookaheadCursor& cursor) const {
+        if (!find_lookahead(this->curves.data(), this->curves.size(), robot, lookahead, cursor))
+            cursor = {this->curves.size() - 1, this->curves.back()->get_length()};
+
+        auto point = this->curves[cursor.curve]->get_travel_point(cursor.s);
+        return {this->curveStarts[cursor.curve] + cursor.s, point, (point - robot).norm()};
+    }
+
+    double Path::get_curve_start(std::size_t i) const {
+        return this->curveStarts[i];
+    }
+
+    const std::vector<const Curve*>& Path::get_curves() const {
+        return this->curves;
+    }
+
+    double Path::get_length() const {
+        double length = 0;
+        for (auto curve: this->curves)
+            length += curve->get_length();
+        return length;
+    }
+
+    const std::vector<Vector2>& Path::get_points() const {
+        return this->points;
+    }
+
+    const std::vector<Joint>& Path::get_joints() const {
+        return this->joints;
+    }
+} // path
@@ -0,0 +1,147 @@
+//
+// Created by Benjamin Lee on 8/26/24.
+//
+
+#ifndef VEX_PATH_PLANNER_PATH_H
+#define VEX_PATH_PLANNER_PATH_H
+
+#include <vector>
+#include "Joint.h"
+
+namespace path {
+    /**
+     * @brief a polyline through N control points, smoothed by a Joint at each of the N-2 interior points.
+     * Consecutive joints share the straight segment between them: the path runs from the end of one joint's second
+     * clothoid straight to the start of the next joint's first clothoid, so no stretch of path is emitted twice.
+     */
+    class Path {
+    public:
+        /**
+         * @param points control points, at least 2
+         * @param sharpness rate of change in curvature of every clothoid
+         * @param maxCurvature maximum curvature of every turn
+         */
+        Path(std::vector<Vector2> points, double sharpness, double maxCurvature);
+
+        Path(const Path& other);
+        Path(Path&& other) noexcept = default;
+        Path& operator=(Path other) noexcept;
+
+        /**
+         * @brief bring every joint and straight segment up to date with the control points.
+         * Joints whose control points have not moved are skipped.
+         */
+        void update();
+
+        /**
+         * @brief move one control point and update only the (at most three) joints and the segments that depend on it
+         * @param i index of the control point
+         * @param pos new position
+         */
+        void set_point(std::size_t i, Vector2 pos);
+
+        /**
+         * @brief sample the whole path as one waypoint stream, reserving space once for all of it.
+         * An owning buffer is filled from each curve's cached waypoints; a fixed buffer is sampled directly.
+         * @param output buffer to add waypoints to
+         * @param ds space between waypoints
+         */
+        void get_waypoints(WaypointBuffer& output, double ds) const;
+
+        /**
+         * @brief sample the whole path into a fixed-capacity buffer without allocating or throwing
+         * @param output buffer over caller storage (output.is_fixed())
+         * @param ds space between waypoints
+         * @return whether every waypoint fit. False without sampling if output is not fixed.
+         */
+        bool get_waypoints_into(WaypointBuffer& output, double ds) const noexcept;
+
+        [[nodiscard]] std::vector<Vector2> get_waypoints(double ds) const;
+
+        /**
+         * @brief sample the whole path with curvature-adaptive spacing, see Curve::get_waypoints_adaptive
+         * @param output buffer to add waypoints to
+         * @param tolerance maximum chord deviation
+         * @param dsMax maximum space between waypoints
+         */
+        void get_waypoints_adaptive(WaypointBuffer& output, double tolerance, double dsMax) const;
+
+        [[nodiscard]] std::vector<Vector2> get_waypoints_adaptive(double tolerance, double dsMax) const;
+
+        /**
+         * @brief waypoints of the whole path, regenerated only if the path changed or ds differs from the last call.
+         * Regenerating reuses the cached waypoints of every curve that did not change.
+         * @param ds space between waypoints
+         * @return read-only view of the cached waypoints
+         */
+        [[nodiscard]] std::shared_ptr<const WaypointBuffer> get_cached_waypoints(double ds) const;
+
+        /**
+         * @brief find the closest point on the path by projecting onto every curve
+         * @param p query point
+         * @return closest point, with s measured from the start of the path
+         */
+        [[nodiscard]] Projection project(Vector2 p) const;
+
+        /**
+         * @brief find the closest point on the path near a previous one. Starting from curve hint, moves on to
+         * the following (or else the preceding) curves while they come closer, so a follower that calls this every
+         * cycle with the same hint projects onto a curve or two per call instead of the whole path.
+         * @param p query point
+         * @param hint index into get_curves() to start from, updated to the curve of the result
+         * @return closest point near the hint, with s measured from the start of the path
+         */
+        [[nodiscard]] Projection project(Vector2 p, std::size_t& hint) const;
+
+        /**
+         * @brief pure pursuit lookahead point: the first point at or after the cursor that is lookahead away from
+         * the robot, found analytically on lines and arcs and by a bracketed root search on clothoids
+         * @param robot robot position
+         * @param lookahead lookahead distance
+         * @param cursor where the previous cycle's search stopped; start from a default cursor
+         * @return the lookahead point with s measured from the start of the path, or the end of the path if no
+         * point ahead is far enough away
+         */
+        [[nodiscard]] Projection get_lookahead(Vector2 robot, double lookahead, LookaheadCursor& cursor) const;
+
+        /**
+         * @param i index into get_curves()
+         * @return arc length from the start of the path to the start of curve i
+         */
+        [[nodiscard]] double get_curve_start(std::size_t i) const;
+
+        /**
+         * @return the curves of the path in order of travel: segment, clothoid, arc (if visible), clothoid, segment, ...
+         */
+        [[nodiscard]] const std::vector<const Curve*>& get_curves() const;
+
+        [[nodiscard]] double get_length() const;
+        [[nodiscard]] const std::vector<Vector2>& get_points() const;
+        [[nodiscard]] const std::vector<Joint>& get_joints() const;
+
+    private:
+        /**
+         * @brief reconfigure the segments touching joints first..last and rebuild the curve list if a corner changed
+         * @param first index of the first joint that was updated
+         * @param last index past the last joint that was updated
+         * @param dirty JointPart flags of all updated joints combined
+         */
+        void update_segments(std::size_t first, std::size_t last, unsigned dirty);
+
+        void rebuild_curves();
+
+        std::vector<Vector2> points; // never resized after construction; the joints point into it
+        std::vector<Joint> joints;
+        std::vector<Line> segments;
+        std::vector<const Curve*> curves;
+        std::vector<double> curveStarts; // arc length at the start of each curve
+
+        double sharpness;
+        double maxCurvature;
+
+        mutable std::shared_ptr<const CachedWaypoints> cache;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_PATH_H
@@ -0,0 +1,122 @@
+//
+// Created by Benjamin Lee on 9/4/24.
+//
+
+#include "ScalarCurves.h"
+
+namespace path {
+    template <typename T>
+    BasicLine<T>::BasicLine(BasicVector2<T> start, BasicVector2<T> end) :
+            start(start), direction(0, 0), length((end - start).norm()), heading((end - start).heading()) {
+        if (this->length > 0)
+            this->direction = (end - start) / this->length;
+    }
+
+    template <typename T>
+    BasicLine<T>::BasicLine(const Line& line) :
+            BasicLine(BasicVector2<T>(line.get_start()), BasicVector2<T>(line.get_end())) {}
+
+    template <typename T>
+    BasicVector2<T> BasicLine<T>::get_point(T s) const {
+        return this->start + this->direction * s;
+    }
+
+    template <typename T>
+    T BasicLine<T>::get_length() const {
+        return this->length;
+    }
+
+    template <typename T>
+    T BasicLine<T>::get_heading(T) const {
+        return this->heading;
+    }
+
+    template <typename T>
+    T BasicLine<T>::get_curvature(T) const {
+        return 0;
+    }
+
+    template <typename T>
+    BasicCircularArc<T>::BasicCircularArc(BasicVector2<T> center, T radius, T thetaStart, T thetaEnd) :
+            center(center), radius(radius), thetaStart(thetaStart), turn(thetaEnd < thetaStart ? -1 : 1) {
+        this->length = radius * (thetaEnd - thetaStart) * this->turn;
+    }
+
+    // direction and length come from the double arc: its angles may round to the same value in T, and a hidden arc
+    // has no length
+    template <typename T>
+    BasicCircularArc<T>::BasicCircularArc(const CircularArc& arc) :
+            center(arc.get_center()), radius(arc.get_radius()), thetaStart(arc.get_start_angle()),
+            turn(arc.get_end_angle() < arc.get_start_angle() ? -1 : 1), length(arc.get_length()) {}
+
+    template <typename T>
+    BasicVector2<T> BasicCircularArc<T>::get_point(T s) const {
+        using std::cos, std::sin;
+        auto theta = this->thetaStart + this->turn * s / this->radius;
+        return this->center + BasicVector2<T>(cos(theta), sin(theta)) * this->radius;
+    }
+
+    template <typename T>
+    T BasicCircularArc<T>::get_length() const {
+        return this->length;
+    }
+
+    template <typename T>
+    T BasicCircularArc<T>::get_heading(T s) const {
+        return this->thetaStart + this->turn * (s / this->radius + T(M_PI_2));
+    }
+
+    template <typename T>
+    T BasicCircularArc<T>::get_curvature(T) const {
+        return this->turn / this->radius;
+    }
+
+    template <typename T>
+    BasicClothoid<T>::BasicClothoid(BasicVector2<T> initialPosition, T initialHeading, T length, T sharpness,
+                                    T initialCurvature, bool reversed) :
+            form(initialPosition, initialHeading, initialCurvature, sharpness / 2, length), length(length),
+            reversed(reversed) {}
+
+    template <typename T>
+    BasicClothoid<T>::BasicClothoid(const Clothoid& clothoid) :
+            BasicClothoid(BasicVector2<T>(clothoid.get_initial_position()), T(clothoid.get_initial_heading()),
+                          T(clothoid.get_length()), T(clothoid.get_sharpness()), T(clothoid.get_initial_curvature()),
+                          clothoid.is_reversed()) {}
+
+    template <typename T>
+    BasicVector2<T> BasicClothoid<T>::get_point(T t) const {
+        return this->form.get_point(t);
+    }
+
+    template <typename T>
+    BasicVector2<T> BasicClothoid<T>::get_travel_point(T s) const {
+        return this->get_point(this->reversed ? this->length - s : s);
+    }
+
+    template <typename T>
+    T BasicClothoid<T>::get_length() const {
+        return this->length;
+    }
+
+    template <typename T>
+    T BasicClothoid<T>::get_heading(T s) const {
+        auto x = this->reversed ? this->length - s : s;
+        return this->form.get_heading(x) + (this->reversed ? T(M_PI) : T(0));
+    }
+
+    template <typename T>
+    T BasicClothoid<T>::get_curvature(T s) const {
+        auto x = this->reversed ? this->length - s : s;
+        return (this->reversed ? -1 : 1) * this->form.get_curvature(x);
+    }
+
+    template class BasicLine<double>;
+    template class BasicLine<float>;
+    template class BasicLine<Fixed>;
+    template class BasicCircularArc<double>;
+    template class BasicCircularArc<float>;
+    template class BasicCircularArc<Fixed>;
+    template class BasicClothoid<double>;
+    template class BasicClothoid<float>;
+    template class BasicClothoid<Fixed>;
+} // path
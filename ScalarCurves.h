@@ -0,0 +1,103 @@
+//
+// Created by Benjamin Lee on 9/4/24.
+//
+
+#ifndef VEX_PATH_PLANNER_SCALARCURVES_H
+#define VEX_PATH_PLANNER_SCALARCURVES_H
+
+#include "Vector2.h"
+#include "Fixed.h"
+#include "Line.h"
+#include "CircularArc.h"
+#include "Clothoid.h"
+#include "ClothoidForm.h"
+
+namespace path {
+    /*
+     * Evaluators of the curve primitives in a scalar type T: double, float or Fixed.
+     * Paths are planned with the double curves; these copy a curve's geometry into T so that a target without a fast
+     * double-precision FPU can evaluate position, heading and curvature along it in its own arithmetic. Arc lengths are
+     * measured along the direction of travel, as in Curve. Member functions are defined in ScalarCurves.cpp and
+     * instantiated there for those three types only.
+     */
+
+    template <typename T>
+    class BasicLine {
+    public:
+        BasicLine(BasicVector2<T> start, BasicVector2<T> end);
+        explicit BasicLine(const Line& line);
+
+        [[nodiscard]] BasicVector2<T> get_point(T s) const;
+        [[nodiscard]] T get_length() const;
+        [[nodiscard]] T get_heading(T s) const;
+        [[nodiscard]] T get_curvature(T s) const;
+
+    private:
+        BasicVector2<T> start;
+        BasicVector2<T> direction; // unit
+        T length;
+        T heading;
+    };
+
+    template <typename T>
+    class BasicCircularArc {
+    public:
+        /**
+         * @param center center of the circle
+         * @param radius radius of the circle
+         * @param thetaStart polar angle of the start about the center
+         * @param thetaEnd polar angle of the end about the center; the arc turns left if it is above thetaStart
+         */
+        BasicCircularArc(BasicVector2<T> center, T radius, T thetaStart, T thetaEnd);
+        explicit BasicCircularArc(const CircularArc& arc);
+
+        [[nodiscard]] BasicVector2<T> get_point(T s) const;
+        [[nodiscard]] T get_length() const;
+        [[nodiscard]] T get_heading(T s) const;
+        [[nodiscard]] T get_curvature(T s) const;
+
+    private:
+        BasicVector2<T> center;
+        T radius;
+        T thetaStart;
+        T turn; // 1 turning left, -1 turning right
+        T length;
+    };
+
+    template <typename T>
+    class BasicClothoid {
+    public:
+        BasicClothoid(BasicVector2<T> initialPosition, T initialHeading, T length, T sharpness, T initialCurvature,
+                      bool reversed = false);
+        explicit BasicClothoid(const Clothoid& clothoid);
+
+        /**
+         * @param t arc length from the initial position, regardless of direction of travel
+         * @return point at t, see ClothoidForm::get_point
+         */
+        [[nodiscard]] BasicVector2<T> get_point(T t) const;
+
+        [[nodiscard]] BasicVector2<T> get_travel_point(T s) const;
+        [[nodiscard]] T get_length() const;
+        [[nodiscard]] T get_heading(T s) const;
+        [[nodiscard]] T get_curvature(T s) const;
+
+    private:
+        ClothoidForm<T> form;
+        T length;
+        bool reversed;
+    };
+
+    extern template class BasicLine<double>;
+    extern template class BasicLine<float>;
+    extern template class BasicLine<Fixed>;
+    extern template class BasicCircularArc<double>;
+    extern template class BasicCircularArc<float>;
+    extern template class BasicCircularArc<Fixed>;
+    extern template class BasicClothoid<double>;
+    extern template class BasicClothoid<float>;
+    extern template class BasicClothoid<Fixed>;
+
+} // path
+
+#endif //VEX_PATH_PLANNER_SCALARCURVES_H
@@ -0,0 +1,227 @@
+//
+// Created by Benjamin Lee on 9/5/24.
+//
+
+#include "ScalarCurves.h"
+#include "Fresnel.h"
+#include "Fixed.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+/*
+ * Tolerance test for the float and Fixed evaluators against the double reference. Each check samples its inputs,
+ * records the worst absolute error and fails if that exceeds the bound stated next to it. Inputs are first rounded to
+ * the narrow type and the reference is evaluated at the rounded value, so the bounds cover only the narrow arithmetic.
+ * Exits with the number of failed checks.
+ */
+
+using namespace path;
+
+namespace {
+    int failures = 0;
+
+    /**
+     * @brief tracks the worst error of one quantity and reports it against its bound
+     */
+    struct Check {
+        const char* name;
+        double bound;
+        double worst = 0;
+        double worstArg = 0;
+
+        Check(const char* name, double bound) : name(name), bound(bound) {}
+
+        void add(double error, double arg) {
+            if (!(error <= this->worst)) {
+                this->worst = error;
+                this->worstArg = arg;
+            }
+        }
+
+        ~Check() {
+            bool ok = this->worst <= this->bound;
+            std::printf("%-4s %-40s worst %.2e (at %g), bound %.0e\n", ok ? "ok" : "FAIL", this->name, this->worst,
+                        this->worstArg, this->bound);
+            if (!ok)
+                ++failures;
+        }
+    };
+
+    template <typename T>
+    Vector2 to_double(BasicVector2<T> v) {
+        return {(double)v.x, (double)v.y};
+    }
+
+    /**
+     * @return |a - b| for angles, modulo 2 pi
+     */
+    double angle_error(double a, double b) {
+        return std::fabs(std::remainder(a - b, 2 * M_PI));
+    }
+
+    /**
+     * @brief round a value to T and back, so the reference sees exactly what the narrow evaluator sees
+     */
+    template <typename T>
+    double round_to(double x) {
+        return (double)T(x);
+    }
+
+    std::mt19937 rng(2024);
+
+    double uniform(double lo, double hi) {
+        return std::uniform_real_distribution<double>(lo, hi)(rng);
+    }
+
+    /**
+     * @return point at arc length s along the direction of travel
+     */
+    template <typename Basic, typename T>
+    BasicVector2<T> travel_point(const Basic& basic, T s) {
+        return basic.get_point(s);
+    }
+
+    template <typename T>
+    BasicVector2<T> travel_point(const BasicClothoid<T>& basic, T s) {
+        return basic.get_travel_point(s);
+    }
+
+    /**
+     * @brief compare position, heading and curvature of a narrow evaluator with its double curve at evenly spaced arc
+     * lengths along the direction of travel
+     */
+    template <typename T, typename Basic>
+    void compare_curve(const Curve& curve, const Basic& basic, Check& position, Check& heading, Check& curvature) {
+        constexpr int SAMPLES = 64;
+        auto length = (double)basic.get_length();
+        for (int i = 0; i <= SAMPLES; ++i) {
+            auto s = round_to<T>(length * i / SAMPLES);
+            position.add((to_double(travel_point(basic, T(s))) - curve.get_travel_point(s)).norm(), s);
+            heading.add(angle_error((double)basic.get_heading(T(s)), curve.get_heading(s)), s);
+            curvature.add(std::fabs((double)basic.get_curvature(T(s)) - curve.get_curvature(s)), s);
+        }
+    }
+
+    /**
+     * @brief lines, arcs and clothoids inside a 20 x 20 field, lengths up to 10, curvatures up to 2
+     * @param positionBound bound on position error of lines and arcs
+     * @param angleBound bound on heading and curvature error of lines and arcs
+     * @param clothoidPositionBound bound on position error of clothoids
+     * @param clothoidAngleBound bound on heading and curvature error of clothoids, which turn by up to 160 radians and
+     * whose half sharpness is rounded to T
+     */
+    template <typename T>
+    void test_curves(const char* type, double positionBound, double angleBound, double clothoidPositionBound,
+                     double clothoidAngleBound) {
+        std::printf("%s curves\n", type);
+        constexpr int CURVES = 200;
+        {
+            Check position("BasicLine position", positionBound);
+            Check heading("BasicLine heading", angleBound);
+            Check curvature("BasicLine curvature", angleBound);
+            for (int i = 0; i < CURVES; ++i) {
+                Vector2 a(round_to<T>(uniform(-10, 10)), round_to<T>(uniform(-10, 10)));
+                Vector2 b(round_to<T>(uniform(-10, 10)), round_to<T>(uniform(-10, 10)));
+                Line line(a, b);
+                compare_curve<T>(line, BasicLine<T>(line), position, heading, curvature);
+            }
+        }
+        {
+            Check position("BasicCircularArc position", positionBound);
+            Check heading("BasicCircularArc heading", angleBound);
+            Check curvature("BasicCircularArc curvature", angleBound);
+            for (int i = 0; i < CURVES; ++i) {
+                Vector2 center(round_to<T>(uniform(-5, 5)), round_to<T>(uniform(-5, 5)));
+                auto start = round_to<T>(uniform(-M_PI, M_PI));
+                auto end = round_to<T>(start + uniform(-2 * M_PI, 2 * M_PI));
+                CircularArc arc(center, start, end, round_to<T>(uniform(0.5, 5)));
+                compare_curve<T>(arc, BasicCircularArc<T>(arc), position, heading, curvature);
+            }
+        }
+        {
+            Check position("BasicClothoid position", clothoidPositionBound);
+            Check heading("BasicClothoid heading", clothoidAngleBound);
+            Check curvature("BasicClothoid curvature", clothoidAngleBound);
+            for (int i = 0; i < CURVES; ++i) {
+                // sharpness from nearly zero to steep, so both the Fresnel form and the arc form are exercised
+                auto sharpness = round_to<T>(std::copysign(std::pow(10, uniform(-4, 0.5)), uniform(-1, 1)));
+                Clothoid clothoid({round_to<T>(uniform(-10, 10)), round_to<T>(uniform(-10, 10))},
+                                  round_to<T>(uniform(-M_PI, M_PI)), round_to<T>(uniform(0.1, 10)), sharpness,
+                                  round_to<T>(uniform(-2, 2)), i % 2 == 1);
+                BasicClothoid<T> basic(clothoid);
+                compare_curve<T>(clothoid, basic, position, heading, curvature);
+            }
+        }
+    }
+
+    /**
+     * @brief fresnel_vec in T against the double implementation, on both sides of every branch boundary
+     */
+    template <typename T>
+    void test_fresnel(const char* name, double bound) {
+        Check check(name, bound);
+        constexpr int SAMPLES = 200000;
+        for (int i = -SAMPLES; i <= SAMPLES; ++i) {
+            auto s = round_to<T>(200.0 * i / SAMPLES * std::fabs((double)i / SAMPLES));
+            check.add((to_double(fresnel_vec(T(s))) - fresnel_vec(s)).norm(), s);
+        }
+    }
+
+    void test_fixed_math() {
+        std::printf("Fixed math\n");
+        constexpr int SAMPLES = 100000;
+        // range reduction subtracts 2 pi rounded to Q16.16, which adds about 5e-6 of error per turn
+        for (double range: {2 * M_PI, 100.0}) {
+            auto bound = 5e-5 + 5e-6 * range / (2 * M_PI);
+            Check sinCheck(range < 100 ? "sin on [-2 pi, 2 pi]" : "sin on [-100, 100]", bound);
+            Check cosCheck(range < 100 ? "cos on [-2 pi, 2 pi]" : "cos on [-100, 100]", bound);
+            for (int i = -SAMPLES; i <= SAMPLES; ++i) {
+                auto x = Fixed(range * i / SAMPLES);
+                sinCheck.add(std::fabs((double)sin(x) - std::sin((double)x)), (double)x);
+                cosCheck.add(std::fabs((double)cos(x) - std::cos((double)x)), (double)x);
+            }
+        }
+        {
+            Check check("atan2 around the circle, radii 1e-3 to 1e4", 5e-5);
+            for (int i = 0; i < SAMPLES; ++i) {
+                auto r = std::pow(10, uniform(-3, 4));
+                auto angle = uniform(-M_PI, M_PI);
+                auto y = Fixed(r * std::sin(angle));
+                auto x = Fixed(r * std::cos(angle));
+                if (x == 0 && y == 0)
+                    continue;
+                check.add(angle_error((double)atan2(y, x), std::atan2((double)y, (double)x)), angle);
+            }
+        }
+        {
+            Check check("sqrt on [0, 30000]", 2e-5);
+            for (int i = 0; i <= SAMPLES; ++i) {
+                auto x = Fixed(30000.0 * i / SAMPLES * i / SAMPLES);
+                check.add(std::fabs((double)sqrt(x) - std::sqrt((double)x)), (double)x);
+            }
+        }
+        {
+            Check check("hypot on [-1000, 1000]^2", 2e-5);
+            for (int i = 0; i < SAMPLES; ++i) {
+                auto x = Fixed(uniform(-1000, 1000));
+                auto y = Fixed(uniform(-1000, 1000));
+                check.add(std::fabs((double)hypot(x, y) - std::hypot((double)x, (double)y)), (double)x);
+            }
+        }
+    }
+}
+
+int main() {
+    test_curves<float>("float", 1e-5, 1e-5, 1e-4, 1e-4);
+    test_curves<Fixed>("Fixed", 5e-4, 2e-4, 1e-2, 2e-3);
+
+    std::printf("Fresnel integrals on [-200, 200]\n");
+    test_fresnel<float>("fresnel_vec(float)", 3e-7);
+    test_fresnel<Fixed>("fresnel_vec(Fixed)", 5e-5);
+
+    test_fixed_math();
+
+    std::printf("%d check(s) failed\n", failures);
+    return failures;
+}
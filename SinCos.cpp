@@ -0,0 +1,213 @@
+//
+// Created by Benjamin Lee on 8/24/24.
+//
+
+#include "SinCos.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SINCOS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SINCOS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SINCOS_NEON
+#endif
+
+namespace path {
+    // x = q pi/2 + r, with pi/2 split so that q * PIO2_HI is exact for |q| < 2^20
+    static constexpr double TWO_OVER_PI = 0.636619772367581343076;
+    static constexpr double PIO2_HI = 1.57079632673412561417e+00;
+    static constexpr double PIO2_LO = 6.07710050650619224932e-11;
+
+    // adding then subtracting 1.5 * 2^52 rounds to the nearest integer, which is left in the low mantissa bits
+    static constexpr double ROUND_MAGIC = 6755399441055744.0;
+
+    // Taylor coefficients, |r| <= pi/4
+    static constexpr double S1 = -1.0 / 6;
+    static constexpr double S2 = 1.0 / 120;
+    static constexpr double S3 = -1.0 / 5040;
+    static constexpr double S4 = 1.0 / 362880;
+    static constexpr double S5 = -1.0 / 39916800;
+    static constexpr double S6 = 1.0 / 6227020800;
+    static constexpr double S7 = -1.0 / 1307674368000;
+    static constexpr double C1 = 1.0 / 24;
+    static constexpr double C2 = -1.0 / 720;
+    static constexpr double C3 = 1.0 / 40320;
+    static constexpr double C4 = -1.0 / 3628800;
+    static constexpr double C5 = 1.0 / 479001600;
+    static constexpr double C6 = -1.0 / 87178291200;
+    static constexpr double C7 = 1.0 / 20922789888000;
+
+#if defined(SINCOS_AVX2)
+    const int SINCOS_BATCH_WIDTH = 4;
+
+    void sincos_batch(const double* x, double* sinOut, double* cosOut, int n) {
+        const auto magic = _mm256_set1_pd(ROUND_MAGIC);
+        const auto one = _mm256_set1_pd(1);
+        const auto half = _mm256_set1_pd(0.5);
+        const auto bit1 = _mm256_set1_epi64x(1);
+        const auto bit2 = _mm256_set1_epi64x(2);
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            auto v = _mm256_loadu_pd(x + i);
+            auto t = _mm256_add_pd(_mm256_mul_pd(v, _mm256_set1_pd(TWO_OVER_PI)), magic);
+            auto q = _mm256_sub_pd(t, magic);
+            auto qi = _mm256_castpd_si256(t);
+
+            auto r = _mm256_sub_pd(_mm256_sub_pd(v, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_HI))),
+                                   _mm256_mul_pd(q, _mm256_set1_pd(PIO2_LO)));
+            auto r2 = _mm256_mul_pd(r, r);
+
+            auto ps = _mm256_add_pd(_mm256_mul_pd(r2, _mm256_set1_pd(S7)), _mm256_set1_pd(S6));
+            ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(S5));
+            ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(S4));
+            ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(S3));
+            ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(S2));
+            ps = _mm256_add_pd(_mm256_mul_pd(ps, r2), _mm256_set1_pd(S1));
+            auto sinR = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, r2), ps));
+
+            auto pc = _mm256_add_pd(_mm256_mul_pd(r2, _mm256_set1_pd(C7)), _mm256_set1_pd(C6));
+            pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(C5));
+            pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(C4));
+            pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(C3));
+            pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(C2));
+            pc = _mm256_add_pd(_mm256_mul_pd(pc, r2), _mm256_set1_pd(C1));
+            auto cosR = _mm256_add_pd(_mm256_sub_pd(one, _mm256_mul_pd(half, r2)),
+                                      _mm256_mul_pd(_mm256_mul_pd(r2, r2), pc));
+
+            // odd quadrants swap sin and cos; blendv only looks at the sign bit
+            auto swap = _mm256_castsi256_pd(_mm256_slli_epi64(qi, 63));
+            auto s = _mm256_blendv_pd(sinR, cosR, swap);
+            auto c = _mm256_blendv_pd(cosR, sinR, swap);
+
+            auto sinSign = _mm256_slli_epi64(_mm256_and_si256(qi, bit2), 62);
+            auto cosSign = _mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(qi, bit1), bit2), 62);
+            _mm256_storeu_pd(sinOut + i, _mm256_xor_pd(s, _mm256_castsi256_pd(sinSign)));
+            _mm256_storeu_pd(cosOut + i, _mm256_xor_pd(c, _mm256_castsi256_pd(cosSign)));
+        }
+
+        for (; i < n; ++i) {
+            sinOut[i] = std::sin(x[i]);
+            cosOut[i] = std::cos(x[i]);
+        }
+    }
+#elif defined(SINCOS_SSE2)
+    const int SINCOS_BATCH_WIDTH = 2;
+
+    void sincos_batch(const double* x, double* sinOut, double* cosOut, int n) {
+        const auto magic = _mm_set1_pd(ROUND_MAGIC);
+        const auto one = _mm_set1_pd(1);
+        const auto half = _mm_set1_pd(0.5);
+        const auto bit1 = _mm_set1_epi64x(1);
+        const auto bit2 = _mm_set1_epi64x(2);
+
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            auto v = _mm_loadu_pd(x + i);
+            auto t = _mm_add_pd(_mm_mul_pd(v, _mm_set1_pd(TWO_OVER_PI)), magic);
+            auto q = _mm_sub_pd(t, magic);
+            auto qi = _mm_castpd_si128(t);
+
+            auto r = _mm_sub_pd(_mm_sub_pd(v, _mm_mul_pd(q, _mm_set1_pd(PIO2_HI))),
+                                _mm_mul_pd(q, _mm_set1_pd(PIO2_LO)));
+            auto r2 = _mm_mul_pd(r, r);
+
+            auto ps = _mm_add_pd(_mm_mul_pd(r2, _mm_set1_pd(S7)), _mm_set1_pd(S6));
+            ps = _mm_add_pd(_mm_mul_pd(ps, r2), _mm_set1_pd(S5));
+            ps = _mm_add_pd(_mm_mul_pd(ps, r2), _mm_set1_pd(S4));
+            ps = _mm_add_pd(_mm_mul_pd(ps, r2), _mm_set1_pd(S3));
+            ps = _mm_add_pd(_mm_mul_pd(ps, r2), _mm_set1_pd(S2));
+            ps = _mm_add_pd(_mm_mul_pd(ps, r2), _mm_set1_pd(S1));
+            auto sinR = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, r2), ps));
+
+            auto pc = _mm_add_pd(_mm_mul_pd(r2, _mm_set1_pd(C7)), _mm_set1_pd(C6));
+            pc = _mm_add_pd(_mm_mul_pd(pc, r2), _mm_set1_pd(C5));
+            pc = _mm_add_pd(_mm_mul_pd(pc, r2), _mm_set1_pd(C4));
+            pc = _mm_add_pd(_mm_mul_pd(pc, r2), _mm_set1_pd(C3));
+            pc = _mm_add_pd(_mm_mul_pd(pc, r2), _mm_set1_pd(C2));
+            pc = _mm_add_pd(_mm_mul_pd(pc, r2), _mm_set1_pd(C1));
+            auto cosR = _mm_add_pd(_mm_sub_pd(one, _mm_mul_pd(half, r2)), _mm_mul_pd(_mm_mul_pd(r2, r2), pc));
+
+            // odd quadrants swap sin and cos. SSE2 has no 64-bit arithmetic shift, so widen the sign bit through the
+            // upper 32-bit half of each lane instead.
+            auto swapBit = _mm_srai_epi32(_mm_slli_epi64(qi, 63), 31);
+            auto swap = _mm_castsi128_pd(_mm_shuffle_epi32(swapBit, _MM_SHUFFLE(3, 3, 1, 1)));
+            auto s = _mm_or_pd(_mm_and_pd(swap, cosR), _mm_andnot_pd(swap, sinR));
+            auto c = _mm_or_pd(_mm_and_pd(swap, sinR), _mm_andnot_pd(swap, cosR));
+
+            auto sinSign = _mm_slli_epi64(_mm_and_si128(qi, bit2), 62);
+            auto cosSign = _mm_slli_epi64(_mm_and_si128(_mm_add_epi64(qi, bit1), bit2), 62);
+            _mm_storeu_pd(sinOut + i, _mm_xor_pd(s, _mm_castsi128_pd(sinSign)));
+            _mm_storeu_pd(cosOut + i, _mm_xor_pd(c, _mm_castsi128_pd(cosSign)));
+        }
+
+        for (; i < n; ++i) {
+            sinOut[i] = std::sin(x[i]);
+            cosOut[i] = std::cos(x[i]);
+        }
+    }
+#elif defined(SINCOS_NEON)
+    const int SINCOS_BATCH_WIDTH = 2;
+
+    void sincos_batch(const double* x, double* sinOut, double* cosOut, int n) {
+        const auto one = vdupq_n_f64(1);
+        const auto half = vdupq_n_f64(0.5);
+        const auto bit1 = vdupq_n_s64(1);
+        const auto bit2 = vdupq_n_s64(2);
+
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            auto v = vld1q_f64(x + i);
+            auto q = vrndnq_f64(vmulq_n_f64(v, TWO_OVER_PI));
+            auto qi = vcvtq_s64_f64(q);
+
+            auto r = vsubq_f64(vsubq_f64(v, vmulq_n_f64(q, PIO2_HI)), vmulq_n_f64(q, PIO2_LO));
+            auto r2 = vmulq_f64(r, r);
+
+            auto ps = vaddq_f64(vmulq_n_f64(r2, S7), vdupq_n_f64(S6));
+            ps = vaddq_f64(vmulq_f64(ps, r2), vdupq_n_f64(S5));
+            ps = vaddq_f64(vmulq_f64(ps, r2), vdupq_n_f64(S4));
+            ps = vaddq_f64(vmulq_f64(ps, r2), vdupq_n_f64(S3));
+            ps = vaddq_f64(vmulq_f64(ps, r2), vdupq_n_f64(S2));
+            ps = vaddq_f64(vmulq_f64(ps, r2), vdupq_n_f64(S1));
+            auto sinR = vaddq_f64(r, vmulq_f64(vmulq_f64(r, r2), ps));
+
+            auto pc = vaddq_f64(vmulq_n_f64(r2, C7), vdupq_n_f64(C6));
+            pc = vaddq_f64(vmulq_f64(pc, r2), vdupq_n_f64(C5));
+            pc = vaddq_f64(vmulq_f64(pc, r2), vdupq_n_f64(C4));
+            pc = vaddq_f64(vmulq_f64(pc, r2), vdupq_n_f64(C3));
+            pc = vaddq_f64(vmulq_f64(pc, r2), vdupq_n_f64(C2));
+            pc = vaddq_f64(vmulq_f64(pc, r2), vdupq_n_f64(C1));
+            auto cosR = vaddq_f64(vsubq_f64(one, vmulq_f64(half, r2)), vmulq_f64(vmulq_f64(r2, r2), pc));
+
+            // odd quadrants swap sin and cos
+            auto swap = vtstq_s64(qi, bit1);
+            auto s = vbslq_f64(swap, cosR, sinR);
+            auto c = vbslq_f64(swap, sinR, cosR);
+
+            auto sinSign = vshlq_n_u64(vreinterpretq_u64_s64(vandq_s64(qi, bit2)), 62);
+            auto cosSign = vshlq_n_u64(vreinterpretq_u64_s64(vandq_s64(vaddq_s64(qi, bit1), bit2)), 62);
+            vst1q_f64(sinOut + i, vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(s), sinSign)));
+            vst1q_f64(cosOut + i, vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(c), cosSign)));
+        }
+
+        for (; i < n; ++i) {
+            sinOut[i] = std::sin(x[i]);
+            cosOut[i] = std::cos(x[i]);
+        }
+    }
+#else
+    const int SINCOS_BATCH_WIDTH = 1;
+
+    void sincos_batch(const double* x, double* sinOut, double* cosOut, int n) {
+        for (int i = 0; i < n; ++i) {
+            sinOut[i] = std::sin(x[i]);
+            cosOut[i] = std::cos(x[i]);
+        }
+    }
+#endif
+} // path
@@ -0,0 +1,27 @@
+//
+// Created by Benjamin Lee on 8/24/24.
+//
+
+#ifndef VEX_PATH_PLANNER_SINCOS_H
+#define VEX_PATH_PLANNER_SINCOS_H
+
+namespace path {
+    /**
+     * @brief number of doubles processed per instruction by sincos_batch (1 when no SIMD path is compiled in)
+     */
+    extern const int SINCOS_BATCH_WIDTH;
+
+    /**
+     * @brief sine and cosine of many angles at once.
+     * Uses AVX2 or SSE2 on x86 and NEON on AArch64, whichever the compiler targets, with a scalar fallback.
+     * The vector path reduces by pi/2 (Cody-Waite) and evaluates degree 15/16 polynomials; the absolute error is below
+     * 4e-16 for |x| < 1e5.
+     * @param x angles in radians
+     * @param sinOut sin(x[i]) is written to sinOut[i]
+     * @param cosOut cos(x[i]) is written to cosOut[i]
+     * @param n number of angles
+     */
+    void sincos_batch(const double* x, double* sinOut, double* cosOut, int n);
+} // path
+
+#endif //VEX_PATH_PLANNER_SINCOS_H
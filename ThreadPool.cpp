@@ -0,0 +1,121 @@
+//
+// Created by Benjamin Lee on 8/27/24.
+//
+
+#include "ThreadPool.h"
+
+namespace path {
+    // pool and queue index of the worker running on this thread, if any
+    static thread_local const ThreadPool* currentPool = nullptr;
+    static thread_local std::size_t currentQueue = 0;
+
+    ThreadPool::ThreadPool(std::size_t numThreads) {
+        numThreads = std::max<std::size_t>(numThreads, 1);
+        this->queues.reserve(numThreads);
+        for (std::size_t i = 0; i < numThreads; ++i)
+            this->queues.push_back(std::make_unique<Queue>());
+
+        this->workers.reserve(numThreads);
+        for (std::size_t i = 0; i < numThreads; ++i)
+            this->workers.emplace_back(&ThreadPool::work, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        this->wait();
+        {
+            std::lock_guard<std::mutex> lock(this->sleepMutex);
+            this->stopping = true;
+        }
+        this->taskAvailable.notify_all();
+        for (auto& worker: this->workers)
+            worker.join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        auto index = currentPool == this ? currentQueue : this->nextQueue++ % this->queues.size();
+        this->pending++;
+        {
+            std::lock_guard<std::mutex> lock(this->queues[index]->mutex);
+            this->queues[index]->tasks.push_back(std::move(task));
+        }
+        this->queued++;
+
+        // taking the lock orders this notification after any worker's check of queued, so none sleeps through it
+        { std::lock_guard<std::mutex> lock(this->sleepMutex); }
+        this->taskAvailable.notify_one();
+    }
+
+    void ThreadPool::wait() {
+        while (this->pending > 0) {
+            if (this->run_pending_task())
+                continue;
+            std::unique_lock<std::mutex> lock(this->sleepMutex);
+            this->allDone.wait(lock, [this] { return this->pending == 0 || this->queued > 0; });
+        }
+    }
+
+    bool ThreadPool::run_pending_task() {
+        std::function<void()> task;
+        if (!this->take(currentPool == this ? currentQueue : 0, task))
+            return false;
+        task();
+        this->finish_task();
+        return true;
+    }
+
+    std::size_t ThreadPool::size() const {
+        return this->workers.size();
+    }
+
+    bool ThreadPool::take(std::size_t home, std::function<void()>& task) {
+        if (this->queued == 0)
+            return false;
+
+        auto n = this->queues.size();
+        for (std::size_t k = 0; k < n; ++k) {
+            auto& queue = *this->queues[(home + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+
+            // newest of our own tasks is the most likely to be in cache; steal the oldest, i.e. the largest, of others
+            if (k == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            this->queued--;
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::finish_task() {
+        if (--this->pending == 0) {
+            std::lock_guard<std::mutex> lock(this->sleepMutex);
+            this->allDone.notify_all();
+        }
+    }
+
+    void ThreadPool::work(std::size_t index) {
+        currentPool = this;
+        currentQueue = index;
+
+        std::function<void()> task;
+        while (true) {
+            if (this->take(index, task)) {
+                task();
+                task = nullptr;
+                this->finish_task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(this->sleepMutex);
+            this->taskAvailable.wait(lock, [this] { return this->stopping || this->queued > 0; });
+            if (this->stopping && this->queued == 0)
+                return;
+        }
+    }
+} // path
@@ -0,0 +1,114 @@
+//
+// Created by Benjamin Lee on 8/27/24.
+//
+
+#ifndef VEX_PATH_PLANNER_THREADPOOL_H
+#define VEX_PATH_PLANNER_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace path {
+    /**
+     * @brief fixed set of worker threads with one task queue each.
+     * A worker runs its own newest task first and, when its queue is empty, steals the oldest task of another worker.
+     * Tasks submitted from a worker go to that worker's queue; tasks submitted from elsewhere are dealt round-robin.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @param numThreads number of workers, at least 1
+         */
+        explicit ThreadPool(std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency()));
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief finish every submitted task, then stop the workers
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief queue a task. Tasks must not throw.
+         * @param task function to run on some worker
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief block until every submitted task has finished, running queued tasks on the calling thread meanwhile.
+         * Must not be called from inside a task, which would wait for itself.
+         */
+        void wait();
+
+        /**
+         * @brief run one queued task on the calling thread, if there is one
+         * @return whether a task was run
+         */
+        bool run_pending_task();
+
+        /**
+         * @brief run body(0), ..., body(n - 1) as separate tasks and return once all of them finished.
+         * The calling thread runs queued tasks while it waits, so this may be nested inside another task.
+         * @param n number of tasks
+         * @param body callable as void(std::size_t)
+         */
+        template <typename F>
+        void parallel_for(std::size_t n, F&& body) {
+            std::atomic<std::size_t> remaining{n};
+            for (std::size_t i = 0; i < n; ++i) {
+                this->submit([&body, &remaining, i] {
+                    body(i);
+                    remaining--;
+                });
+            }
+            while (remaining > 0) {
+                if (!this->run_pending_task())
+                    std::this_thread::yield();
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /**
+         * @brief take a task, preferring the back of queue home and then the fronts of the others
+         * @param home index of the queue to try first
+         * @param task set to the task taken
+         * @return whether a task was taken
+         */
+        bool take(std::size_t home, std::function<void()>& task);
+
+        void finish_task();
+
+        void work(std::size_t index);
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        std::atomic<std::size_t> pending{0}; // submitted but not finished
+        std::atomic<std::size_t> queued{0};  // submitted but not started
+        std::atomic<std::size_t> nextQueue{0};
+
+        std::mutex sleepMutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable allDone;
+        bool stopping = false;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_THREADPOOL_H
@@ -0,0 +1,101 @@
+//
+// Created by Benjamin Lee on 8/30/24.
+//
+
+#include "Trajectory.h"
+#include <algorithm>
+
+namespace path {
+    Trajectory::Trajectory(const Path& path, MotionLimits limits, double ds, double startVelocity,
+                           double endVelocity) :
+            path(&path) {
+        VelocityProfile profile(path, limits, startVelocity, endVelocity);
+        profile.get_samples(this->knots, ds);
+
+        const auto& curves = path.get_curves();
+        auto duration = this->knots.back().t;
+
+        // curve of each knot, and the time each curve starts by inverting s(t) on the knot interval containing it
+        this->knotCurves.resize(this->knots.size());
+        this->curveStartTimes.assign(curves.size(), duration);
+        this->curveStartTimes[0] = 0;
+        std::size_t curve = 0;
+        for (std::size_t k = 0; k < this->knots.size(); ++k) {
+            while (curve + 1 < curves.size() && path.get_curve_start(curve + 1) <= this->knots[k].s) {
+                ++curve;
+                auto start = path.get_curve_start(curve);
+                const auto& prev = this->knots[k - (k > 0)];
+                const auto& next = this->knots[k];
+                auto fraction = next.s > prev.s ? (start - prev.s) / (next.s - prev.s) : 0;
+                // for constant acceleration s is quadratic in t; v^2 is linear in s
+                auto v = std::sqrt(prev.v * prev.v + fraction * (next.v * next.v - prev.v * prev.v));
+                this->curveStartTimes[curve] = prev.v + v > 0 ? prev.t + 2 * (start - prev.s) / (prev.v + v) : prev.t;
+            }
+            this->knotCurves[k] = (std::uint32_t)curve;
+        }
+
+        // one bucket per knot on average
+        auto numBuckets = this->knots.size();
+        this->bucketWidth = duration > 0 ? duration / numBuckets : 1;
+        this->timeIndex.resize(numBuckets + 1);
+        std::size_t knot = 0;
+        for (std::size_t b = 0; b <= numBuckets; ++b) {
+            while (knot + 1 < this->knots.size() && this->knots[knot + 1].t <= b * this->bucketWidth)
+                ++knot;
+            this->timeIndex[b] = (std::uint32_t)knot;
+        }
+    }
+
+    void Trajectory::seek(double t, TrajectoryCursor& cursor) const {
+        if (cursor.knot >= this->knots.size() || this->knots[cursor.knot].t > t) {
+            auto bucket = std::min((std::size_t)(t / this->bucketWidth), this->timeIndex.size() - 1);
+            cursor.knot = this->timeIndex[bucket];
+        }
+        while (cursor.knot + 2 < this->knots.size() && this->knots[cursor.knot + 1].t <= t)
+            ++cursor.knot;
+        cursor.curve = this->knotCurves[cursor.knot];
+    }
+
+    TrajectoryState Trajectory::evaluate(double t, const TrajectoryCursor& cursor) const {
+        const auto& k0 = this->knots[cursor.knot];
+        const auto& k1 = this->knots[std::min(cursor.knot + 1, this->knots.size() - 1)];
+
+        // constant acceleration between knots
+        auto dt = k1.t - k0.t;
+        auto a = dt > 0 ? (k1.v - k0.v) / dt : 0;
+        auto tau = std::clamp(t - k0.t, 0.0, dt);
+        auto s = std::min(k0.s + (k0.v + a * tau / 2) * tau, k1.s);
+
+        const auto& curves = this->path->get_curves();
+        auto curve = cursor.curve;
+        while (curve + 1 < curves.size() && this->path->get_curve_start(curve + 1) <= s)
+            ++curve;
+        auto local = s - this->path->get_curve_start(curve);
+
+        return {k0.t + tau, s, k0.v + a * tau, a, curves[curve]->get_travel_point(local),
+                curves[curve]->get_heading(local), curves[curve]->get_curvature(local)};
+    }
+
+    TrajectoryState Trajectory::sample(double t) const {
+        TrajectoryCursor cursor{this->knots.size(), 0};
+        return this->sample(t, cursor);
+    }
+
+    TrajectoryState Trajectory::sample(double t, TrajectoryCursor& cursor) const {
+        t = std::clamp(t, 0.0, this->get_duration());
+        this->seek(t, cursor);
+        return this->evaluate(t, cursor);
+    }
+
+    double Trajectory::get_duration() const {
+        return this->knots.back().t;
+    }
+
+    double Trajectory::get_length() const {
+        return this->knots.back().s;
+    }
+
+    double Trajectory::get_curve_start_time(std::size_t i) const {
+        return this->curveStartTimes[i];
+    }
+} // path
@@ -0,0 +1,95 @@
+//
+// Created by Benjamin Lee on 8/30/24.
+//
+
+#ifndef VEX_PATH_PLANNER_TRAJECTORY_H
+#define VEX_PATH_PLANNER_TRAJECTORY_H
+
+#include <cstdint>
+#include <vector>
+#include "Path.h"
+#include "VelocityProfile.h"
+
+namespace path {
+    /**
+     * @brief where the robot should be at time t
+     */
+    struct TrajectoryState {
+        double t;
+        double s;
+        double v;
+        double a;
+        Vector2 position;
+        double heading;
+        double curvature;
+    };
+
+    /**
+     * @brief position of the previous query, so that queries at increasing times resume where the last one stopped
+     */
+    struct TrajectoryCursor {
+        std::size_t knot = 0;
+        std::size_t curve = 0;
+    };
+
+    /**
+     * @brief a path timed by a velocity profile.
+     * The profile is sampled into time knots every ds of arc length with constant acceleration between knots. Each knot
+     * records the curve it lies on, and a uniform time-bucket index maps any t to a knot at or just before it, so
+     * random queries cost O(1) on average and queries at increasing times with a cursor cost O(1) each.
+     * The path must outlive the trajectory and must not change while it is in use.
+     */
+    class Trajectory {
+    public:
+        /**
+         * @param path path to follow
+         * @param limits velocity, acceleration and lateral acceleration limits
+         * @param ds space between time knots
+         * @param startVelocity (optional) velocity at the start
+         * @param endVelocity (optional) velocity at the end
+         */
+        Trajectory(const Path& path, MotionLimits limits, double ds, double startVelocity = 0,
+                   double endVelocity = 0);
+
+        /**
+         * @param t time since the start, clamped to [0, get_duration()]
+         * @return state at t
+         */
+        [[nodiscard]] TrajectoryState sample(double t) const;
+
+        /**
+         * @brief state at t, resuming from the previous query. Moving back in time falls back to the time index.
+         * @param t time since the start, clamped to [0, get_duration()]
+         * @param cursor where the previous query stopped; start from a default cursor
+         * @return state at t
+         */
+        [[nodiscard]] TrajectoryState sample(double t, TrajectoryCursor& cursor) const;
+
+        [[nodiscard]] double get_duration() const;
+        [[nodiscard]] double get_length() const;
+
+        /**
+         * @param i index into the path's curves
+         * @return time at which the trajectory reaches the start of curve i
+         */
+        [[nodiscard]] double get_curve_start_time(std::size_t i) const;
+
+    private:
+        /**
+         * @brief move the cursor to the knot interval and curve containing t
+         */
+        void seek(double t, TrajectoryCursor& cursor) const;
+
+        [[nodiscard]] TrajectoryState evaluate(double t, const TrajectoryCursor& cursor) const;
+
+        const Path* path;
+        std::vector<MotionSample> knots;
+        std::vector<std::uint32_t> knotCurves;   // curve containing each knot
+        std::vector<std::uint32_t> timeIndex;    // last knot at or before the start of each time bucket
+        std::vector<double> curveStartTimes;
+        double bucketWidth;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_TRAJECTORY_H
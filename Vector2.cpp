@@ -4,63 +4,86 @@
 
 #include "Vector2.h"
 #include "MathUtils.h"
+#include <type_traits>
 
 namespace path {
-    std::string Vector2::str() const {
-        return "(" + std::to_string(x) + "  " + std::to_string(y) + ")";
+    template <typename T>
+    std::string BasicVector2<T>::str() const {
+        return "(" + std::to_string((double)x) + "  " + std::to_string((double)y) + ")";
     }
 
-    std::string Vector2::latex() const {
-        return "\\left(" + std::to_string(x) + "," + std::to_string(y) + "\\right)";
+    template <typename T>
+    std::string BasicVector2<T>::latex() const {
+        return "\\left(" + std::to_string((double)x) + "," + std::to_string((double)y) + "\\right)";
     }
     
-    double Vector2::norm() const {
-        return std::sqrt(x*x + y*y);
+    template <typename T>
+    T BasicVector2<T>::norm() const {
+        // squaring overflows Q16.16 past 181, so Fixed has its own hypot
+        if constexpr (std::is_floating_point_v<T>)
+            return std::sqrt(x*x + y*y);
+        else
+            return hypot(x, y);
     }
     
-    double Vector2::norm_squared() const {
+    template <typename T>
+    T BasicVector2<T>::norm_squared() const {
         return x*x + y*y;
     }
     
-    Vector2 Vector2::normalize() const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::normalize() const {
         return *this / this->norm();
     }
     
-    double Vector2::dot(Vector2 other) const {
+    template <typename T>
+    T BasicVector2<T>::dot(BasicVector2 other) const {
         return this->x * other.x + this->y * other.y;
     }
     
-    double Vector2::cross(Vector2 other) const {
+    template <typename T>
+    T BasicVector2<T>::cross(BasicVector2 other) const {
         return this->x * other.y - this->y * other.x;
     }
     
-    double Vector2::comp(Vector2 direction) const {
+    template <typename T>
+    T BasicVector2<T>::comp(BasicVector2 direction) const {
         return this->dot(direction) / direction.norm();
     }
     
-    Vector2 Vector2::proj(Vector2 direction) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::proj(BasicVector2 direction) const {
         return direction * (this->dot(direction) / direction.norm_squared());
     }
     
-    double Vector2::orthogonal_comp(Vector2 direction) const {
-        return std::fabs(this->cross(direction) / direction.norm());
+    template <typename T>
+    T BasicVector2<T>::orthogonal_comp(BasicVector2 direction) const {
+        using std::fabs;
+        return fabs(this->cross(direction) / direction.norm());
     }
     
-    Vector2 Vector2::rotate(double theta) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::rotate(T theta) const {
+        using std::cos, std::sin;
         auto c = cos(theta);
         auto s = sin(theta);
-        return {(double)(c * this->x - s * this->y), (double)(s * this->x + c * this->y)};
+        return {c * this->x - s * this->y, s * this->x + c * this->y};
     }
 
-    double Vector2::angle(Vector2 other) const {
+    template <typename T>
+    T BasicVector2<T>::angle(BasicVector2 other) const {
+        using std::acos;
         return acos(this->dot(other) / (this->norm() * other.norm()));
     }
 
-    double Vector2::oriented_angle(Vector2 other) const {
-        return this->angle(other) * sign<double>(this->cross(other));
+    template <typename T>
+    T BasicVector2<T>::oriented_angle(BasicVector2 other) const {
+        return this->angle(other) * sign<T>(this->cross(other));
     }
 
-    double Vector2::heading() const {
+    template <typename T>
+    T BasicVector2<T>::heading() const {
+        using std::atan2;
         return atan2(this->y, this->x);
     }
 
@@ -69,80 +92,104 @@ namespace path {
      * @param axis axis of reflection
      * @return reflected vector
      */
-    Vector2 Vector2::reflect_about(Vector2 axis) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::reflect_about(BasicVector2 axis) const {
         return *this - axis * ( this->dot(axis) * 2 );
     }
 
-    Vector2 Vector2::operator-() const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator-() const {
         return {-this->x, -this->y};
     }
 
-    Vector2 Vector2::operator+() const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator+() const {
         return *this;
     }
 
-    Vector2 Vector2::operator+(Vector2 other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator+(BasicVector2 other) const {
         return {this->x + other.x, this->y + other.y};
     }
 
-    Vector2 Vector2::operator-(Vector2 other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator-(BasicVector2 other) const {
         return {this->x - other.x, this->y - other.y};
     }
 
-    Vector2 Vector2::operator*(Vector2 other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator*(BasicVector2 other) const {
         return {this->x * other.x, this->y * other.y};
     }
 
-    Vector2 Vector2::operator*(double other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator*(T other) const {
         return {this->x * other, this->y * other};
     }
 
-    Vector2 Vector2::operator/(Vector2 other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator/(BasicVector2 other) const {
         return {this->x / other.x, this->y / other.y};
     }
 
-    Vector2 Vector2::operator/(double other) const {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator/(T other) const {
         return {this->x / other, this->y / other};
     }
 
-    Vector2 Vector2::operator+=(Vector2 other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator+=(BasicVector2 other) {
         this->x += other.x;
         this->y += other.y;
         return *this;
     }
 
-    Vector2 Vector2::operator-=(Vector2 other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator-=(BasicVector2 other) {
         this->x -= other.x;
         this->y -= other.y;
         return *this;
     }
 
-    Vector2 Vector2::operator*=(Vector2 other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator*=(BasicVector2 other) {
         this->x *= other.x;
         this->y *= other.y;
         return *this;
     }
 
-    Vector2 Vector2::operator*=(double other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator*=(T other) {
         this->x *= other;
         this->y *= other;
         return *this;
     }
 
-    Vector2 Vector2::operator/=(Vector2 other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator/=(BasicVector2 other) {
         this->x /= other.x;
         this->y /= other.y;
         return *this;
     }
 
-    Vector2 Vector2::operator/=(double other) {
+    template <typename T>
+    BasicVector2<T> BasicVector2<T>::operator/=(T other) {
         this->x /= other;
         this->y /= other;
         return *this;
     }
 
-    Vector2 operator*(double a, Vector2 b) {
-        return b * a;
+    template <typename T>
+    bool BasicVector2<T>::operator==(BasicVector2 other) const {
+        return this->x == other.x && this->y == other.y;
+    }
+
+    template <typename T>
+    bool BasicVector2<T>::operator!=(BasicVector2 other) const {
+        return !(*this == other);
     }
-}
 
+    template class BasicVector2<double>;
+    template class BasicVector2<float>;
+    template class BasicVector2<Fixed>;
+}
@@ -7,16 +7,30 @@
 
 #include <cmath>
 #include <string>
+#include "Fixed.h"
 
 namespace path {
-    class Vector2 {
+    /**
+     * @brief 2D vector over a scalar type T: double (Vector2), float or Fixed.
+     * Member functions are defined in Vector2.cpp and instantiated there for those three types only.
+     * @tparam T scalar type
+     */
+    template <typename T>
+    class BasicVector2 {
     public:
-        double x;
-        double y;
+        T x;
+        T y;
 
-        Vector2() = default;
+        BasicVector2() = default;
 
-        Vector2(double x, double y) : x(x), y(y) {}
+        constexpr BasicVector2(T x, T y) : x(x), y(y) {}
+
+        /**
+         * @brief convert from another scalar type
+         * @param other vector to convert
+         */
+        template <typename U>
+        constexpr explicit BasicVector2(BasicVector2<U> other) : x(T(other.x)), y(T(other.y)) {}
 
         [[nodiscard]] std::string str() const;
         [[nodiscard]] std::string latex() const;
@@ -25,106 +39,116 @@ namespace path {
          * @brief |this|
          * @return vector norm (magnitude)
          */
-        [[nodiscard]] double norm() const;
+        [[nodiscard]] T norm() const;
 
         /**
          * @brief |this|^2
          * @return square of vector norm (magnitude)
          */
-        [[nodiscard]] double norm_squared() const;
+        [[nodiscard]] T norm_squared() const;
 
         /**
          * @brief normalize the vector
          * @return unit direction vector
          */
-        [[nodiscard]] Vector2 normalize() const;
+        [[nodiscard]] BasicVector2 normalize() const;
 
         /**
          * @brief dot product
          * @param other another vector
          * @return this • other
          */
-        [[nodiscard]] double dot(Vector2 other) const;
+        [[nodiscard]] T dot(BasicVector2 other) const;
 
         /**
          * @brief cross product this x other
          * @param other another vector
          * @return this x other
          */
-        [[nodiscard]] double cross(Vector2 other) const;
+        [[nodiscard]] T cross(BasicVector2 other) const;
 
         /**
          * @brief component of a vector projected onto this
          * @param direction direction vector
          * @return a.comp(b) = comp_b(a)
          */
-        [[nodiscard]] double comp(Vector2 direction) const;
+        [[nodiscard]] T comp(BasicVector2 direction) const;
 
         /**
          * @brief project onto a direction vector
          * @param direction direction vector
          * @return a.proj(b) = proj_b(a)
          */
-        [[nodiscard]] Vector2 proj(Vector2 direction) const;
+        [[nodiscard]] BasicVector2 proj(BasicVector2 direction) const;
 
         /**
          * @brief orthogonal component of this onto a direction vector (distance from point to line)
          * @param direction direction vector
          * @return distance from the head of this to the line passing through direction vector
          */
-        [[nodiscard]] double orthogonal_comp(Vector2 direction) const;
+        [[nodiscard]] T orthogonal_comp(BasicVector2 direction) const;
 
         /**
          * @brief rotate CCW by theta radians about origin
          * @param theta
          * @return rotated vector
          */
-        [[nodiscard]] Vector2 rotate(double theta) const;
+        [[nodiscard]] BasicVector2 rotate(T theta) const;
 
         /**
          * @brief Get angle between two vectors.
          * @param other another vector
          * @return angle between this and other
          */
-        [[nodiscard]] double angle(Vector2 other) const;
+        [[nodiscard]] T angle(BasicVector2 other) const;
 
         /**
          * @brief Get oriented/signed angle from this vector to another vector.
          * @param other another vector
          * @return angle from this vector to the other vector.
          */
-        [[nodiscard]] double oriented_angle(Vector2 other) const;
+        [[nodiscard]] T oriented_angle(BasicVector2 other) const;
 
         /**
          * @brief get vector heading in radians
          * @return vector heading in radians
          */
-        [[nodiscard]] double heading() const;
+        [[nodiscard]] T heading() const;
 
         /**
          * @brief reflect this vector about an axis
          * @param axis axis of reflection
          * @return reflected vector
          */
-        [[nodiscard]] Vector2 reflect_about(Vector2 axis) const;
-
-        Vector2 operator-() const;
-        Vector2 operator+() const;
-        Vector2 operator+(Vector2 other) const;
-        Vector2 operator-(Vector2 other) const;
-        Vector2 operator*(Vector2 other) const;
-        Vector2 operator*(double other) const;
-        Vector2 operator/(Vector2 other) const;
-        Vector2 operator/(double other) const;
-        Vector2 operator+=(Vector2 other);
-        Vector2 operator-=(Vector2 other);
-        Vector2 operator*=(Vector2 other);
-        Vector2 operator*=(double other);
-        Vector2 operator/=(Vector2 other);
-        Vector2 operator/=(double other);
+        [[nodiscard]] BasicVector2 reflect_about(BasicVector2 axis) const;
+
+        BasicVector2 operator-() const;
+        BasicVector2 operator+() const;
+        BasicVector2 operator+(BasicVector2 other) const;
+        BasicVector2 operator-(BasicVector2 other) const;
+        BasicVector2 operator*(BasicVector2 other) const;
+        BasicVector2 operator*(T other) const;
+        BasicVector2 operator/(BasicVector2 other) const;
+        BasicVector2 operator/(T other) const;
+        BasicVector2 operator+=(BasicVector2 other);
+        BasicVector2 operator-=(BasicVector2 other);
+        BasicVector2 operator*=(BasicVector2 other);
+        BasicVector2 operator*=(T other);
+        BasicVector2 operator/=(BasicVector2 other);
+        BasicVector2 operator/=(T other);
+        bool operator==(BasicVector2 other) const;
+        bool operator!=(BasicVector2 other) const;
+
+        friend BasicVector2 operator*(T a, BasicVector2 b) {
+            return b * a;
+        }
     };
 
-    Vector2 operator*(double a, Vector2 b);
+    extern template class BasicVector2<double>;
+    extern template class BasicVector2<float>;
+    extern template class BasicVector2<Fixed>;
+
+    using Vector2 = BasicVector2<double>;
 } // namespace path
 
 #endif //VEX_PATH_PLANNER_VECTOR2_H
@@ -0,0 +1,207 @@
+//
+// Created by Benjamin Lee on 8/29/24.
+//
+
+#include "VelocityProfile.h"
+#include <algorithm>
+#include <cassert>
+
+namespace path {
+    VelocityProfile::VelocityProfile(const std::vector<const Curve*>& curves, MotionLimits limits,
+                                     double startVelocity, double endVelocity) :
+            limits(limits) {
+        assert(limits.maxVelocity > 0 && limits.maxAcceleration > 0 && limits.maxDeceleration > 0 &&
+               limits.maxLateralAcceleration > 0);
+
+        // |kappa| at or below this is slow enough for maxVelocity
+        auto curvatureCap = limits.maxLateralAcceleration / (limits.maxVelocity * limits.maxVelocity);
+
+        // split each curve where kappa changes sign and where |kappa| crosses the cap, so that on every section the
+        // limit is either constant or a hyperbola over a linear, positive |kappa|
+        auto addPiece = [&](double sa, double sb, double ka, double kb) {
+            if (sb <= sa)
+                return;
+            auto slope = (kb - ka) / (sb - sa);
+            if ((ka - curvatureCap) * (kb - curvatureCap) < 0) {
+                auto sc = sa + (curvatureCap - ka) / slope;
+                this->add_section(sa, sc, ka, slope);
+                this->add_section(sc, sb, curvatureCap, slope);
+            } else {
+                this->add_section(sa, sb, ka, slope);
+            }
+        };
+
+        double s = 0;
+        for (auto curve: curves) {
+            auto length = curve->get_length();
+            if (length <= 0)
+                continue;
+            auto k0 = curve->get_curvature(0);
+            auto k1 = curve->get_curvature(length);
+            if (k0 * k1 < 0) {
+                auto sz = s + length * std::fabs(k0) / (std::fabs(k0) + std::fabs(k1));
+                addPiece(s, sz, std::fabs(k0), 0);
+                addPiece(sz, s + length, 0, std::fabs(k1));
+            } else {
+                addPiece(s, s + length, std::fabs(k0), std::fabs(k1));
+            }
+            s += length;
+        }
+
+        if (this->sections.empty())
+            return;
+
+        // forward pass: accelerate as hard as allowed, following the limit where it is lower
+        auto u = std::min(startVelocity * startVelocity, this->limit(this->sections.front(), 0));
+        for (auto& section: this->sections) {
+            section.forward = u;
+            auto m = section.accelTangent;
+            u = std::min(u + 2 * limits.maxAcceleration * (section.s1 - section.s0),
+                         this->limit(section, m) + 2 * limits.maxAcceleration * (section.s1 - m));
+        }
+
+        // backward pass: the same with deceleration, from the end
+        auto& last = this->sections.back();
+        u = std::min(endVelocity * endVelocity, this->limit(last, last.s1));
+        for (auto it = this->sections.rbegin(); it != this->sections.rend(); ++it) {
+            it->backward = u;
+            auto m = it->decelTangent;
+            u = std::min(u + 2 * limits.maxDeceleration * (it->s1 - it->s0),
+                         this->limit(*it, m) + 2 * limits.maxDeceleration * (m - it->s0));
+        }
+    }
+
+    VelocityProfile::VelocityProfile(const Path& path, MotionLimits limits, double startVelocity,
+                                     double endVelocity) :
+            VelocityProfile(path.get_curves(), limits, startVelocity, endVelocity) {}
+
+    void VelocityProfile::add_section(double s0, double s1, double curvature, double slope) {
+        Section section{s0, s1, false, curvature, slope, 0, 0, s1, s0};
+        auto curvatureCap = this->limits.maxLateralAcceleration /
+                            (this->limits.maxVelocity * this->limits.maxVelocity);
+        section.capped = curvature + slope * (s1 - s0) / 2 <= curvatureCap;
+
+        if (!section.capped) {
+            // U' = -A slope / |kappa|^2, so U' = 2a where |kappa| = sqrt(-A slope / 2a) and U' = -2d where
+            // |kappa| = sqrt(A slope / 2d). U is convex, so it is followed on one side of that point and left along
+            // the tangent on the other.
+            auto lateral = this->limits.maxLateralAcceleration;
+            if (slope < 0) {
+                auto k = std::sqrt(-lateral * slope / (2 * this->limits.maxAcceleration));
+                section.accelTangent = std::clamp(s0 + (k - curvature) / slope, s0, s1);
+            } else if (slope > 0) {
+                auto k = std::sqrt(lateral * slope / (2 * this->limits.maxDeceleration));
+                section.decelTangent = std::clamp(s0 + (k - curvature) / slope, s0, s1);
+            }
+        }
+        this->sections.push_back(section);
+    }
+
+    double VelocityProfile::limit(const Section& section, double s) const {
+        auto vMax2 = this->limits.maxVelocity * this->limits.maxVelocity;
+        if (section.capped)
+            return vMax2;
+        return std::min(vMax2, this->limits.maxLateralAcceleration /
+                               (section.curvature + section.slope * (s - section.s0)));
+    }
+
+    double VelocityProfile::limit_slope(const Section& section, double s) const {
+        if (section.capped)
+            return 0;
+        auto k = section.curvature + section.slope * (s - section.s0);
+        return -this->limits.maxLateralAcceleration * section.slope / (k * k);
+    }
+
+    const VelocityProfile::Section& VelocityProfile::find_section(double s) const {
+        auto it = std::upper_bound(this->sections.begin(), this->sections.end(), s,
+                                   [](double value, const Section& section) { return value < section.s0; });
+        return it == this->sections.begin() ? *it : *(it - 1);
+    }
+
+    double VelocityProfile::evaluate(double s, double& slope) const {
+        slope = 0;
+        if (this->sections.empty())
+            return 0;
+
+        const auto& section = this->find_section(s);
+        s = std::clamp(s, section.s0, section.s1);
+        auto a2 = 2 * this->limits.maxAcceleration;
+        auto d2 = 2 * this->limits.maxDeceleration;
+
+        // the profile is the lowest of: accelerating from the section start, the forward pass following or leaving
+        // the limit, decelerating into the section end, and the backward pass following or leaving the limit
+        auto u = section.forward + a2 * (s - section.s0);
+        slope = a2;
+
+        auto m = std::min(s, section.accelTangent);
+        auto candidate = this->limit(section, m) + a2 * (s - m);
+        if (candidate < u) {
+            u = candidate;
+            slope = s < section.accelTangent ? this->limit_slope(section, s) : a2;
+        }
+
+        candidate = section.backward + d2 * (section.s1 - s);
+        if (candidate < u) {
+            u = candidate;
+            slope = -d2;
+        }
+
+        m = std::max(s, section.decelTangent);
+        candidate = this->limit(section, m) + d2 * (m - s);
+        if (candidate < u) {
+            u = candidate;
+            slope = s > section.decelTangent ? this->limit_slope(section, s) : -d2;
+        }
+
+        return std::max(u, 0.0);
+    }
+
+    double VelocityProfile::get_velocity(double s) const {
+        double slope;
+        return std::sqrt(this->evaluate(s, slope));
+    }
+
+    double VelocityProfile::get_acceleration(double s) const {
+        // a = v dv/ds = (1/2) d(v^2)/ds
+        double slope;
+        this->evaluate(s, slope);
+        return slope / 2;
+    }
+
+    double VelocityProfile::get_length() const {
+        return this->sections.empty() ? 0 : this->sections.back().s1;
+    }
+
+    void VelocityProfile::get_samples(std::vector<MotionSample>& output, double ds) const {
+        auto length = this->get_length();
+        auto steps = (int)(length / ds);
+        bool useEnd = length - steps * ds > 0.001;
+
+        auto numAdded = (std::size_t)steps + useEnd + 1;
+        if (output.capacity() - output.size() < numAdded)
+            output.reserve(output.size() + numAdded);
+
+        double t = 0;
+        double sPrev = 0;
+        double vPrev = 0;
+        auto emit = [&](double s) {
+            auto v = this->get_velocity(s);
+            if (s > sPrev && v + vPrev > 0)
+                t += 2 * (s - sPrev) / (v + vPrev);
+            output.push_back({t, s, v, this->get_acceleration(s)});
+            sPrev = s;
+            vPrev = v;
+        };
+
+        for (int i = 0; i <= steps; ++i)
+            emit(i * ds);
+        if (useEnd)
+            emit(length);
+    }
+
+    std::vector<MotionSample> VelocityProfile::get_samples(double ds) const {
+        std::vector<MotionSample> output;
+        this->get_samples(output, ds);
+        return output;
+    }
+} // path
@@ -0,0 +1,117 @@
+//
+// Created by Benjamin Lee on 8/29/24.
+//
+
+#ifndef VEX_PATH_PLANNER_VELOCITYPROFILE_H
+#define VEX_PATH_PLANNER_VELOCITYPROFILE_H
+
+#include <vector>
+#include "Curve.h"
+#include "Path.h"
+
+namespace path {
+    /**
+     * @brief limits the velocity profile must respect
+     */
+    struct MotionLimits {
+        double maxVelocity;
+        double maxAcceleration;
+        double maxDeceleration;        // positive
+        double maxLateralAcceleration; // caps speed in turns at sqrt(maxLateralAcceleration / |curvature|)
+    };
+
+    /**
+     * @brief state of the robot at time t
+     */
+    struct MotionSample {
+        double t;
+        double s;
+        double v;
+        double a;
+    };
+
+    /**
+     * @brief time-optimal trapezoidal velocity profile along a sequence of curves.
+     * Works with u = v^2, where constant acceleration is a straight line in s. The speed limit U(s) is
+     * min(maxVelocity^2, maxLateralAcceleration / |kappa(s)|), and kappa is linear in s on every curve, so the curves are
+     * split into sections on which U is either constant or a convex hyperbola. On such a section the forward
+     * (acceleration-limited) and backward (deceleration-limited) passes have closed forms: each either follows U or
+     * leaves it along the tangent of slope 2a (or -2d). The profile is the smaller of the two passes, so velocities are
+     * exact everywhere, including at section boundaries.
+     */
+    class VelocityProfile {
+    public:
+        /**
+         * @param curves curves in order of travel
+         * @param limits velocity, acceleration and lateral acceleration limits, all positive
+         * @param startVelocity (optional) velocity at the start, lowered to the limit there if needed
+         * @param endVelocity (optional) velocity at the end, lowered to the limit there if needed
+         */
+        VelocityProfile(const std::vector<const Curve*>& curves, MotionLimits limits, double startVelocity = 0,
+                        double endVelocity = 0);
+
+        VelocityProfile(const Path& path, MotionLimits limits, double startVelocity = 0, double endVelocity = 0);
+
+        /**
+         * @param s arc length from the start
+         * @return velocity at s
+         */
+        [[nodiscard]] double get_velocity(double s) const;
+
+        /**
+         * @param s arc length from the start
+         * @return acceleration at s, i.e. dv/dt
+         */
+        [[nodiscard]] double get_acceleration(double s) const;
+
+        [[nodiscard]] double get_length() const;
+
+        /**
+         * @brief sample the profile every ds of arc length, plus the end. Time between samples is 2 ds / (v0 + v1),
+         * exact wherever the acceleration is constant (the whole profile apart from stretches that follow the
+         * curvature limit along a clothoid).
+         * @param output vector to add samples to
+         * @param ds space between samples
+         */
+        void get_samples(std::vector<MotionSample>& output, double ds) const;
+
+        [[nodiscard]] std::vector<MotionSample> get_samples(double ds) const;
+
+    private:
+        /**
+         * @brief stretch of the path on which the speed limit is either constant or maxLateralAcceleration / |kappa|
+         * with |kappa| = curvature + slope (s - s0) > 0
+         */
+        struct Section {
+            double s0;
+            double s1;
+            bool capped;      // U = maxVelocity^2 throughout
+            double curvature; // |kappa| at s0
+            double slope;     // d|kappa|/ds
+            double forward;   // forward pass u at s0
+            double backward;  // backward pass u at s1
+            double accelTangent; // where the forward pass leaves U, i.e. U' = 2a
+            double decelTangent; // where the backward pass leaves U, i.e. U' = -2d
+        };
+
+        void add_section(double s0, double s1, double curvature, double slope);
+
+        [[nodiscard]] double limit(const Section& section, double s) const;
+        [[nodiscard]] double limit_slope(const Section& section, double s) const;
+
+        /**
+         * @param s arc length from the start
+         * @param slope set to du/ds
+         * @return u = v^2 at s
+         */
+        double evaluate(double s, double& slope) const;
+
+        [[nodiscard]] const Section& find_section(double s) const;
+
+        MotionLimits limits;
+        std::vector<Section> sections;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_VELOCITYPROFILE_H
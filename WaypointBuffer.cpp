@@ -0,0 +1,191 @@
+//
+// Created by Benjamin Lee on 8/25/24.
+//
+
+#include "WaypointBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace path {
+    WaypointBuffer::WaypointBuffer(double* storage, std::size_t capacity) noexcept :
+            data(storage),
+            cap(capacity),
+            stride((capacity + 7) / 8 * 8),
+            owning(false) {}
+
+    WaypointBuffer::WaypointBuffer(const WaypointBuffer& other) : overflow(other.overflow) {
+        if (other.count == 0)
+            return;
+        this->reserve(other.count);
+        for (int c = 0; c < NUM_CHANNELS; ++c)
+            std::memcpy(this->channel(c), other.channel(c), other.count * sizeof(double));
+        this->count = other.count;
+    }
+
+    WaypointBuffer::WaypointBuffer(WaypointBuffer&& other) noexcept :
+            data(other.data),
+            count(other.count),
+            cap(other.cap),
+            stride(other.stride),
+            owning(other.owning),
+            overflow(other.overflow) {
+        other.data = nullptr;
+        other.count = other.cap = other.stride = 0;
+        other.owning = true;
+        other.overflow = false;
+    }
+
+    WaypointBuffer& WaypointBuffer::operator=(WaypointBuffer other) noexcept {
+        std::swap(this->data, other.data);
+        std::swap(this->count, other.count);
+        std::swap(this->cap, other.cap);
+        std::swap(this->stride, other.stride);
+        std::swap(this->owning, other.owning);
+        std::swap(this->overflow, other.overflow);
+        return *this;
+    }
+
+    WaypointBuffer::~WaypointBuffer() {
+        if (this->owning && this->data)
+            ::operator delete(this->data, std::align_val_t(WAYPOINT_ALIGNMENT));
+    }
+
+    double* WaypointBuffer::channel(int c) const {
+        return this->data + c * this->stride;
+    }
+
+    std::size_t WaypointBuffer::size() const {
+        return this->count;
+    }
+
+    std::size_t WaypointBuffer::capacity() const {
+        return this->cap;
+    }
+
+    bool WaypointBuffer::empty() const {
+        return this->count == 0;
+    }
+
+    bool WaypointBuffer::is_fixed() const {
+        return !this->owning;
+    }
+
+    bool WaypointBuffer::truncated() const {
+        return this->overflow;
+    }
+
+    void WaypointBuffer::mark_truncated() {
+        this->overflow = true;
+    }
+
+    void WaypointBuffer::clear() {
+        this->count = 0;
+        this->overflow = false;
+    }
+
+    void WaypointBuffer::reserve(std::size_t n) {
+        if (!this->owning || n <= this->cap)
+            return;
+
+        auto newStride = (n + 7) / 8 * 8;
+        auto newData = static_cast<double*>(::operator new(storage_size(n) * sizeof(double),
+                                                           std::align_val_t(WAYPOINT_ALIGNMENT)));
+        if (this->data) {
+            for (int c = 0; c < NUM_CHANNELS; ++c)
+                std::memcpy(newData + c * newStride, this->channel(c), this->count * sizeof(double));
+            ::operator delete(this->data, std::align_val_t(WAYPOINT_ALIGNMENT));
+        }
+        this->data = newData;
+        this->cap = newStride;
+        this->stride = newStride;
+    }
+
+    bool WaypointBuffer::push_back(Vector2 pos, double theta, double kappa, double s) {
+        if (this->count == this->cap) {
+            if (!this->owning) {
+                this->overflow = true;
+                return false;
+            }
+            this->reserve(std::max<std::size_t>(2 * this->cap, 64));
+        }
+
+        auto i = this->count++;
+        this->data[i] = pos.x;
+        this->data[this->stride + i] = pos.y;
+        this->data[2 * this->stride + i] = theta;
+        this->data[3 * this->stride + i] = kappa;
+        this->data[4 * this->stride + i] = s;
+        return true;
+    }
+
+    bool WaypointBuffer::append(const WaypointBuffer& other, double sOffset) {
+        auto n = other.count;
+        if (n == 0)
+            return true;
+        if (this->count + n > this->cap) {
+            // grow geometrically like push_back, so appending curve after curve stays amortized linear
+            this->reserve(std::max(this->count + n, 2 * this->cap));
+        }
+        if (this->count + n > this->cap) {
+            n = this->cap - this->count;
+            this->overflow = true;
+        }
+
+        for (int c = 0; c < S; ++c)
+            std::memcpy(this->channel(c) + this->count, other.channel(c), n * sizeof(double));
+        auto s = this->channel(S) + this->count;
+        auto otherS = other.channel(S);
+        for (std::size_t i = 0; i < n; ++i)
+            s[i] = sOffset + otherS[i];
+        this->count += n;
+        return n == other.count;
+    }
+
+    void WaypointBuffer::reverse_from(std::size_t first) noexcept {
+        if (first >= this->count)
+            return;
+        for (int c = 0; c < NUM_CHANNELS; ++c)
+            std::reverse(this->channel(c) + first, this->channel(c) + this->count);
+    }
+
+    double WaypointBuffer::length() const {
+        return this->count ? this->channel(S)[this->count - 1] : 0;
+    }
+
+    Vector2 WaypointBuffer::position(std::size_t i) const {
+        return {this->channel(X)[i], this->channel(Y)[i]};
+    }
+
+    const double* WaypointBuffer::x() const {
+        return this->channel(X);
+    }
+
+    const double* WaypointBuffer::y() const {
+        return this->channel(Y);
+    }
+
+    const double* WaypointBuffer::theta() const {
+        return this->channel(THETA);
+    }
+
+    const double* WaypointBuffer::kappa() const {
+        return this->channel(KAPPA);
+    }
+
+    const double* WaypointBuffer::s() const {
+        return this->channel(S);
+    }
+
+    void WaypointBuffer::append_positions(std::vector<Vector2>& output) const {
+        if (output.capacity() - output.size() < this->size())
+            output.reserve(output.size() + this->size());
+        for (std::size_t i = 0; i < this->count; ++i)
+            output.emplace_back(this->channel(X)[i], this->channel(Y)[i]);
+    }
+
+    std::vector<Vector2> WaypointBuffer::positions() const {
+        std::vector<Vector2> res;
+        this->append_positions(res);
+        return res;
+    }
+} // path
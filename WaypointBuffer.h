@@ -0,0 +1,153 @@
+//
+// Created by Benjamin Lee on 8/25/24.
+//
+
+#ifndef VEX_PATH_PLANNER_WAYPOINTBUFFER_H
+#define VEX_PATH_PLANNER_WAYPOINTBUFFER_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "Vector2.h"
+
+// alignment of every WaypointBuffer channel, enough for a full cache line or an AVX-512 load
+#define WAYPOINT_ALIGNMENT 64
+
+namespace path {
+    /**
+     * @brief caller-owned backing storage for a fixed-capacity WaypointBuffer, e.g. a static or stack array
+     * @tparam N number of waypoints
+     */
+    template <std::size_t N>
+    struct WaypointStorage {
+        static constexpr std::size_t capacity = N;
+        alignas(WAYPOINT_ALIGNMENT) double data[5 * ((N + 7) / 8 * 8)];
+    };
+
+    /**
+     * @brief structure-of-arrays waypoint storage.
+     * Each waypoint has a position (x, y), a heading theta in radians, a signed curvature kappa (positive turns left)
+     * and the arc length s travelled to reach it. Heading, curvature and arc length follow the direction the waypoints
+     * are emitted in. Every channel is a separate aligned array so consumers can stream one channel at a time.
+     *
+     * A default-constructed buffer owns its storage and grows as needed. A buffer built over caller storage has a fixed
+     * capacity: it never allocates or throws, drops waypoints that do not fit and reports that through truncated().
+     */
+    class WaypointBuffer {
+    public:
+        WaypointBuffer() = default;
+
+        /**
+         * @brief fixed-capacity buffer over caller storage
+         * @param storage at least storage_size(capacity) doubles, ideally WAYPOINT_ALIGNMENT-aligned
+         * @param capacity maximum number of waypoints
+         */
+        WaypointBuffer(double* storage, std::size_t capacity) noexcept;
+
+        template <std::size_t N>
+        explicit WaypointBuffer(WaypointStorage<N>& storage) noexcept : WaypointBuffer(storage.data, N) {}
+
+        /**
+         * @brief copies always own their storage
+         */
+        WaypointBuffer(const WaypointBuffer& other);
+        WaypointBuffer(WaypointBuffer&& other) noexcept;
+        WaypointBuffer& operator=(WaypointBuffer other) noexcept;
+        ~WaypointBuffer();
+
+        /**
+         * @param capacity number of waypoints
+         * @return number of doubles of storage a fixed buffer of this capacity needs
+         */
+        static constexpr std::size_t storage_size(std::size_t capacity) {
+            return 5 * ((capacity + 7) / 8 * 8);
+        }
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] std::size_t capacity() const;
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @return whether this buffer uses caller storage and cannot grow
+         */
+        [[nodiscard]] bool is_fixed() const;
+
+        /**
+         * @return whether a waypoint was dropped because a fixed buffer was full. Reset by clear().
+         */
+        [[nodiscard]] bool truncated() const;
+
+        /**
+         * @brief record that waypoints were dropped without calling push_back
+         */
+        void mark_truncated();
+
+        void clear();
+
+        /**
+         * @brief grow an owning buffer to hold at least n waypoints. Does nothing for a fixed buffer.
+         * @param n number of waypoints
+         */
+        void reserve(std::size_t n);
+
+        /**
+         * @brief append a waypoint. A full fixed buffer drops it and sets truncated() instead.
+         * @param pos position
+         * @param theta heading
+         * @param kappa signed curvature
+         * @param s arc length
+         * @return whether the waypoint was stored
+         */
+        bool push_back(Vector2 pos, double theta, double kappa, double s);
+
+        /**
+         * @brief append every waypoint of another buffer, shifting its arc lengths
+         * @param other waypoints to copy
+         * @param sOffset added to each arc length of other
+         * @return whether all of them were stored
+         */
+        bool append(const WaypointBuffer& other, double sOffset);
+
+        /**
+         * @brief reverse the order of the waypoints from index first to the end
+         * @param first first index of the range to reverse
+         */
+        void reverse_from(std::size_t first) noexcept;
+
+        /**
+         * @return arc length of the last waypoint, or 0 if empty. Curves append starting from this arc length.
+         */
+        [[nodiscard]] double length() const;
+
+        [[nodiscard]] Vector2 position(std::size_t i) const;
+
+        [[nodiscard]] const double* x() const;
+        [[nodiscard]] const double* y() const;
+        [[nodiscard]] const double* theta() const;
+        [[nodiscard]] const double* kappa() const;
+        [[nodiscard]] const double* s() const;
+
+        /**
+         * @brief append the positions to a vector
+         * @param output vector to add points to
+         */
+        void append_positions(std::vector<Vector2>& output) const;
+
+        [[nodiscard]] std::vector<Vector2> positions() const;
+
+    private:
+        enum Channel { X, Y, THETA, KAPPA, S, NUM_CHANNELS };
+
+        [[nodiscard]] double* channel(int c) const;
+
+        double* data = nullptr;
+        std::size_t count = 0;
+        std::size_t cap = 0;
+        std::size_t stride = 0; // doubles between the starts of consecutive channels
+        bool owning = true;
+        bool overflow = false;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_WAYPOINTBUFFER_H
@@ -0,0 +1,229 @@
+//
+// Created by Benjamin Lee on 9/3/24.
+//
+
+#include "WaypointGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace path {
+    WaypointGrid::WaypointGrid(double cellSize) : cellSize(cellSize), inverseCellSize(1 / cellSize) {}
+
+    WaypointGrid::WaypointGrid(const WaypointBuffer& waypoints, double cellSize) : WaypointGrid(cellSize) {
+        this->insert(waypoints);
+    }
+
+    std::int32_t WaypointGrid::cell_coordinate(double x) const {
+        return (std::int32_t)std::floor(x * this->inverseCellSize);
+    }
+
+    std::uint64_t WaypointGrid::cell_key(std::int32_t cx, std::int32_t cy) {
+        return (std::uint64_t)(std::uint32_t)cx << 32 | (std::uint32_t)cy;
+    }
+
+    const std::vector<WaypointGrid::Entry>* WaypointGrid::find_cell(std::int32_t cx, std::int32_t cy) const {
+        auto it = this->cellIndex.find(cell_key(cx, cy));
+        return it == this->cellIndex.end() ? nullptr : &this->cells[it->second];
+    }
+
+    void WaypointGrid::insert(std::uint32_t id, Vector2 position) {
+        this->remove(id);
+
+        auto cx = this->cell_coordinate(position.x);
+        auto cy = this->cell_coordinate(position.y);
+        auto [it, added] = this->cellIndex.try_emplace(cell_key(cx, cy), (std::uint32_t)this->cells.size());
+        if (added) {
+            this->cells.emplace_back();
+            this->extend_bounds(cx, cy);
+        }
+
+        auto& cell = this->cells[it->second];
+        if (id >= this->locations.size())
+            this->locations.resize((std::size_t)id + 1, {NO_CELL, 0});
+        this->locations[id] = {it->second, (std::uint32_t)cell.size()};
+        cell.push_back({position, id});
+        ++this->count;
+    }
+
+    void WaypointGrid::insert(const WaypointBuffer& waypoints, std::uint32_t firstId) {
+        if (waypoints.empty())
+            return;
+        if ((std::size_t)firstId + waypoints.size() > this->locations.size())
+            this->locations.resize((std::size_t)firstId + waypoints.size(), {NO_CELL, 0});
+
+        const auto* x = waypoints.x();
+        const auto* y = waypoints.y();
+        for (std::size_t i = 0; i < waypoints.size(); ++i)
+            this->insert(firstId + (std::uint32_t)i, {x[i], y[i]});
+    }
+
+    bool WaypointGrid::remove(std::uint32_t id) {
+        if (!this->contains(id))
+            return false;
+
+        // fill the hole with the cell's last entry
+        auto location = this->locations[id];
+        auto& cell = this->cells[location.cell];
+        auto position = cell[location.slot].position;
+        cell[location.slot] = cell.back();
+        this->locations[cell[location.slot].id].slot = location.slot;
+        cell.pop_back();
+
+        this->locations[id].cell = NO_CELL;
+        --this->count;
+        if (cell.empty())
+            this->drop_cell(location.cell, this->cell_coordinate(position.x), this->cell_coordinate(position.y));
+        return true;
+    }
+
+    void WaypointGrid::drop_cell(std::uint32_t index, std::int32_t cx, std::int32_t cy) {
+        this->cellIndex.erase(cell_key(cx, cy));
+
+        // fill the hole with the last cell
+        auto last = (std::uint32_t)this->cells.size() - 1;
+        if (index != last) {
+            this->cells[index] = std::move(this->cells[last]);
+            auto moved = this->cells[index].front().position;
+            this->cellIndex[cell_key(this->cell_coordinate(moved.x), this->cell_coordinate(moved.y))] = index;
+            for (const auto& entry: this->cells[index])
+                this->locations[entry.id].cell = index;
+        }
+        this->cells.pop_back();
+
+        // only a cell on the edge of the used range can shrink it
+        if (cx == this->minX || cx == this->maxX || cy == this->minY || cy == this->maxY) {
+            this->minX = this->minY = 0;
+            this->maxX = this->maxY = -1;
+            for (const auto& item: this->cellIndex)
+                this->extend_bounds((std::int32_t)(item.first >> 32), (std::int32_t)(std::uint32_t)item.first);
+        }
+    }
+
+    void WaypointGrid::extend_bounds(std::int32_t cx, std::int32_t cy) {
+        if (this->maxX < this->minX) {
+            this->minX = this->maxX = cx;
+            this->minY = this->maxY = cy;
+        } else {
+            this->minX = std::min(this->minX, cx);
+            this->minY = std::min(this->minY, cy);
+            this->maxX = std::max(this->maxX, cx);
+            this->maxY = std::max(this->maxY, cy);
+        }
+    }
+
+    void WaypointGrid::remove(std::uint32_t firstId, std::uint32_t count) {
+        for (std::uint32_t i = 0; i < count; ++i)
+            this->remove(firstId + i);
+    }
+
+    void WaypointGrid::clear() {
+        this->cells.clear();
+        this->cellIndex.clear();
+        this->locations.clear();
+        this->count = 0;
+        this->minX = this->minY = 0;
+        this->maxX = this->maxY = -1;
+    }
+
+    bool WaypointGrid::contains(std::uint32_t id) const {
+        return id < this->locations.size() && this->locations[id].cell != NO_CELL;
+    }
+
+    Vector2 WaypointGrid::get_position(std::uint32_t id) const {
+        auto location = this->locations[id];
+        return this->cells[location.cell][location.slot].position;
+    }
+
+    void WaypointGrid::query_radius(Vector2 p, double radius, std::vector<std::uint32_t>& ids) const {
+        auto x0 = std::max(this->cell_coordinate(p.x - radius), this->minX);
+        auto x1 = std::min(this->cell_coordinate(p.x + radius), this->maxX);
+        auto y0 = std::max(this->cell_coordinate(p.y - radius), this->minY);
+        auto y1 = std::min(this->cell_coordinate(p.y + radius), this->maxY);
+        auto r2 = radius * radius;
+
+        for (auto cx = x0; cx <= x1; ++cx) {
+            for (auto cy = y0; cy <= y1; ++cy) {
+                const auto* cell = this->find_cell(cx, cy);
+                if (!cell)
+                    continue;
+                for (const auto& entry: *cell) {
+                    if ((entry.position - p).norm_squared() <= r2)
+                        ids.push_back(entry.id);
+                }
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> WaypointGrid::query_radius(Vector2 p, double radius) const {
+        std::vector<std::uint32_t> ids;
+        this->query_radius(p, radius, ids);
+        return ids;
+    }
+
+    bool WaypointGrid::nearest(Vector2 p, std::uint32_t& id, double& distance) const {
+        if (this->count == 0)
+            return false;
+
+        auto px = this->cell_coordinate(p.x);
+        auto py = this->cell_coordinate(p.y);
+        auto best = std::numeric_limits<double>::infinity();
+
+        auto visit = [&](std::int32_t cx, std::int32_t cy) {
+            if (cx < this->minX || cx > this->maxX || cy < this->minY || cy > this->maxY)
+                return;
+            const auto* cell = this->find_cell(cx, cy);
+            if (!cell)
+                return;
+            for (const auto& entry: *cell) {
+                auto d2 = (entry.position - p).norm_squared();
+                if (d2 < best) {
+                    best = d2;
+                    id = entry.id;
+                }
+            }
+        };
+
+        // ring k is the border of the (2k + 1)^2 block around p's cell. Every point outside rings 0, ..., k is at
+        // least k cells plus p's distance to the side of its own cell away, so the search stops once the best point
+        // is closer than that. Rings that miss the used range of cells are empty, so the search starts at the first
+        // ring that reaches it and ends at the last.
+        auto fx = p.x * this->inverseCellSize - px;
+        auto fy = p.y * this->inverseCellSize - py;
+        auto border = std::min({fx, 1 - fx, fy, 1 - fy}) * this->cellSize;
+        auto firstRing = std::max({0, this->minX - px, px - this->maxX, this->minY - py, py - this->maxY});
+        auto lastRing = std::max({px - this->minX, this->maxX - px, py - this->minY, this->maxY - py});
+        for (auto k = firstRing; k <= lastRing; ++k) {
+            if (k == 0) {
+                visit(px, py);
+            } else {
+                for (auto cx = px - k; cx <= px + k; ++cx) {
+                    visit(cx, py - k);
+                    visit(cx, py + k);
+                }
+                for (auto cy = py - k + 1; cy <= py + k - 1; ++cy) {
+                    visit(px - k, cy);
+                    visit(px + k, cy);
+                }
+            }
+            auto reach = k * this->cellSize + border;
+            if (best <= reach * reach)
+                break;
+        }
+
+        distance = std::sqrt(best);
+        return true;
+    }
+
+    std::size_t WaypointGrid::size() const {
+        return this->count;
+    }
+
+    bool WaypointGrid::empty() const {
+        return this->count == 0;
+    }
+
+    double WaypointGrid::get_cell_size() const {
+        return this->cellSize;
+    }
+} // path
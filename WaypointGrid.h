@@ -0,0 +1,147 @@
+//
+// Created by Benjamin Lee on 9/3/24.
+//
+
+#ifndef VEX_PATH_PLANNER_WAYPOINTGRID_H
+#define VEX_PATH_PLANNER_WAYPOINTGRID_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Vector2.h"
+#include "WaypointBuffer.h"
+
+// default cell size: one field tile, in inches
+#define WAYPOINT_GRID_CELL_SIZE 24.0
+
+namespace path {
+    /**
+     * @brief uniform grid over waypoint positions for radius and nearest-neighbour queries.
+     * Each cell keeps its points in one contiguous array, and each id records its cell and slot, so inserting and
+     * removing a point is O(1) and a query only reads the cells it overlaps instead of scanning every waypoint.
+     * Ids are chosen by the caller, e.g. waypoint indices, so that the points of a regenerated joint can be removed
+     * and inserted again without rebuilding the grid.
+     */
+    class WaypointGrid {
+    public:
+        /**
+         * @param cellSize side length of a cell, ideally about the radius of typical queries
+         */
+        explicit WaypointGrid(double cellSize = WAYPOINT_GRID_CELL_SIZE);
+
+        /**
+         * @param waypoints waypoints to index, with ids 0, ..., waypoints.size() - 1
+         * @param cellSize side length of a cell
+         */
+        explicit WaypointGrid(const WaypointBuffer& waypoints, double cellSize = WAYPOINT_GRID_CELL_SIZE);
+
+        /**
+         * @brief add a point, or move it if the id is already in the grid
+         * @param id id of the point
+         * @param position position of the point
+         */
+        void insert(std::uint32_t id, Vector2 position);
+
+        /**
+         * @brief add every waypoint of a buffer
+         * @param waypoints waypoints to add
+         * @param firstId id of the first waypoint; the others follow consecutively
+         */
+        void insert(const WaypointBuffer& waypoints, std::uint32_t firstId = 0);
+
+        /**
+         * @param id id of the point
+         * @return whether the point was in the grid
+         */
+        bool remove(std::uint32_t id);
+
+        /**
+         * @brief remove ids [firstId, firstId + count), skipping any that are not in the grid
+         */
+        void remove(std::uint32_t firstId, std::uint32_t count);
+
+        void clear();
+
+        [[nodiscard]] bool contains(std::uint32_t id) const;
+
+        /**
+         * @param id id of a point in the grid
+         * @return position of the point
+         */
+        [[nodiscard]] Vector2 get_position(std::uint32_t id) const;
+
+        /**
+         * @brief find every point within radius of p
+         * @param p query point
+         * @param radius search radius
+         * @param ids ids of the points found are added here, in no particular order
+         */
+        void query_radius(Vector2 p, double radius, std::vector<std::uint32_t>& ids) const;
+
+        [[nodiscard]] std::vector<std::uint32_t> query_radius(Vector2 p, double radius) const;
+
+        /**
+         * @brief find the closest point to p, searching rings of cells outwards until no unsearched cell can be closer
+         * @param p query point
+         * @param id set to the id of the closest point, if any
+         * @param distance set to the distance to the closest point, if any
+         * @return whether the grid has any points
+         */
+        bool nearest(Vector2 p, std::uint32_t& id, double& distance) const;
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] double get_cell_size() const;
+
+    private:
+        struct Entry {
+            Vector2 position;
+            std::uint32_t id;
+        };
+
+        struct Location {
+            std::uint32_t cell; // index into cells, NO_CELL if the id is not in the grid
+            std::uint32_t slot; // index into the cell's entries
+        };
+
+        static constexpr std::uint32_t NO_CELL = UINT32_MAX;
+
+        [[nodiscard]] std::int32_t cell_coordinate(double x) const;
+        [[nodiscard]] static std::uint64_t cell_key(std::int32_t cx, std::int32_t cy);
+
+        /**
+         * @return the cell at (cx, cy), or nullptr if it has no points
+         */
+        [[nodiscard]] const std::vector<Entry>* find_cell(std::int32_t cx, std::int32_t cy) const;
+
+        /**
+         * @brief remove a cell whose last point was removed, and shrink the used range if the cell was on its edge
+         * @param index index of the cell in cells
+         * @param cx cell coordinate along x
+         * @param cy cell coordinate along y
+         */
+        void drop_cell(std::uint32_t index, std::int32_t cx, std::int32_t cy);
+
+        /**
+         * @brief grow the used range to include the cell at (cx, cy)
+         */
+        void extend_bounds(std::int32_t cx, std::int32_t cy);
+
+        double cellSize;
+        double inverseCellSize;
+
+        std::vector<std::vector<Entry>> cells;
+        std::unordered_map<std::uint64_t, std::uint32_t> cellIndex; // cell key -> index into cells
+        std::vector<Location> locations;                            // by id
+        std::size_t count = 0;
+
+        // range of coordinates of the cells with points, which bounds the nearest-neighbour ring search
+        std::int32_t minX = 0;
+        std::int32_t minY = 0;
+        std::int32_t maxX = -1;
+        std::int32_t maxY = -1;
+    };
+
+} // path
+
+#endif //VEX_PATH_PLANNER_WAYPOINTGRID_H